@@ -180,6 +180,13 @@ public:
                     dy = Float32(cursor()->output()->pos().y()) +
                                  libinput_event_pointer_get_absolute_y_transformed(pointerEvent, cursor()->output()->size().h()) -
                                  cursor()->pos().y();
+
+                    // The cursor has not moved yet if there are coalesced events
+                    if (seat()->imp()->pendingPointerMove)
+                    {
+                        dx -= seat()->imp()->pendingPointerMoveEvent.delta().x();
+                        dy -= seat()->imp()->pendingPointerMoveEvent.delta().y();
+                    }
                 }
                 else
                     dx = dy = 0.f;
@@ -0,0 +1,484 @@
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "stats.h"
+#include "shm.h"
+
+struct Bench bench;
+
+long long int now_us(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (long long int)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+double bench_time_ms(void)
+{
+    if (!bench.started)
+        return 0.0;
+
+    return (double)(now_us(CLOCK_MONOTONIC) - bench.startUs) / 1000.0;
+}
+
+void fatal(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[LBenchmark] ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(EXIT_FAILURE);
+}
+
+/******************** CONNECTIONS ********************/
+
+static void noop() {}
+
+static void wl_output_handle_scale(void *data, struct wl_output *output, int32_t scale)
+{
+    (void)data;
+    (void)output;
+    bench.outputScale = scale;
+}
+
+static void wl_output_handle_mode(void *data, struct wl_output *output, uint32_t flags, int32_t w, int32_t h, int32_t refresh)
+{
+    (void)data;
+    (void)output;
+    (void)refresh;
+
+    if (!(flags & WL_OUTPUT_MODE_CURRENT))
+        return;
+
+    bench.outputWidth = w;
+    bench.outputHeight = h;
+}
+
+static const struct wl_output_listener wl_output_listener =
+{
+    .geometry = &noop,
+    .mode = &wl_output_handle_mode,
+    .done = &noop,
+    .scale = &wl_output_handle_scale
+};
+
+static void xdg_wm_base_handle_ping(void *data, struct xdg_wm_base *wm, uint32_t serial)
+{
+    (void)data;
+    xdg_wm_base_pong(wm, serial);
+}
+
+static const struct xdg_wm_base_listener xdg_wm_base_listener =
+{
+    .ping = &xdg_wm_base_handle_ping
+};
+
+static void wp_presentation_handle_clock_id(void *data, struct wp_presentation *presentation, uint32_t clock)
+{
+    (void)presentation;
+    struct Connection *conn = data;
+    conn->presentationClock = (clockid_t)clock;
+}
+
+static const struct wp_presentation_listener wp_presentation_listener =
+{
+    .clock_id = &wp_presentation_handle_clock_id
+};
+
+static void handle_global(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version)
+{
+    (void)version;
+    struct Connection *conn = data;
+
+    if (strcmp(interface, wl_shm_interface.name) == 0)
+        conn->shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+    else if (strcmp(interface, wl_compositor_interface.name) == 0)
+        conn->compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 3);
+    else if (strcmp(interface, wl_subcompositor_interface.name) == 0)
+        conn->subcompositor = wl_registry_bind(registry, name, &wl_subcompositor_interface, 1);
+    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        conn->xdg_wm_base = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(conn->xdg_wm_base, &xdg_wm_base_listener, conn);
+    }
+    else if (strcmp(interface, wl_output_interface.name) == 0 && !conn->output)
+    {
+        conn->output = wl_registry_bind(registry, name, &wl_output_interface, 2);
+        wl_output_add_listener(conn->output, &wl_output_listener, conn);
+    }
+    else if (strcmp(interface, wp_presentation_interface.name) == 0)
+    {
+        conn->presentation = wl_registry_bind(registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(conn->presentation, &wp_presentation_listener, conn);
+    }
+    else if (strcmp(interface, wp_viewporter_interface.name) == 0)
+        conn->viewporter = wl_registry_bind(registry, name, &wp_viewporter_interface, 1);
+    else if (strcmp(interface, wp_single_pixel_buffer_manager_v1_interface.name) == 0)
+        conn->single_pixel_buffer_manager = wl_registry_bind(registry, name, &wp_single_pixel_buffer_manager_v1_interface, 1);
+}
+
+static void handle_global_remove(void *data, struct wl_registry *registry, uint32_t name)
+{
+    (void)data;
+    (void)registry;
+    (void)name;
+}
+
+static const struct wl_registry_listener registry_listener =
+{
+    .global = handle_global,
+    .global_remove = handle_global_remove,
+};
+
+struct Connection *connection_create(void)
+{
+    if (bench.connectionsCount == MAX_CONNECTIONS)
+        fatal("Too many client connections, the limit is %d.", MAX_CONNECTIONS);
+
+    struct Connection *conn = &bench.connections[bench.connectionsCount];
+    conn->presentationClock = CLOCK_MONOTONIC;
+    conn->display = wl_display_connect(NULL);
+
+    if (!conn->display)
+        fatal("Failed to connect to the Wayland display.");
+
+    bench.connectionsCount++;
+    conn->registry = wl_display_get_registry(conn->display);
+    wl_registry_add_listener(conn->registry, &registry_listener, conn);
+
+    /* Globals, then their initial events */
+    wl_display_roundtrip(conn->display);
+    wl_display_roundtrip(conn->display);
+
+    if (!conn->shm || !conn->compositor || !conn->subcompositor || !conn->xdg_wm_base)
+        fatal("The compositor lacks wl_shm, wl_compositor, wl_subcompositor or xdg_wm_base.");
+
+    return conn;
+}
+
+void connections_dispatch(int timeoutMs)
+{
+    struct pollfd fds[MAX_CONNECTIONS];
+
+    for (int i = 0; i < bench.connectionsCount; i++)
+    {
+        struct wl_display *display = bench.connections[i].display;
+
+        while (wl_display_prepare_read(display) != 0)
+            wl_display_dispatch_pending(display);
+
+        if (wl_display_flush(display) == -1 && errno != EAGAIN)
+            fatal("Lost the connection with the compositor.");
+
+        fds[i].fd = wl_display_get_fd(display);
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+
+    const int ret = poll(fds, (nfds_t)bench.connectionsCount, timeoutMs);
+
+    for (int i = 0; i < bench.connectionsCount; i++)
+    {
+        struct wl_display *display = bench.connections[i].display;
+
+        if (ret > 0 && (fds[i].revents & POLLIN))
+        {
+            if (wl_display_read_events(display) == -1)
+                fatal("Lost the connection with the compositor.");
+        }
+        else
+            wl_display_cancel_read(display);
+
+        if (wl_display_dispatch_pending(display) == -1)
+            fatal("Lost the connection with the compositor.");
+    }
+}
+
+/******************** BUFFERS ********************/
+
+static void wl_buffer_handle_release(void *data, struct wl_buffer *wl_buffer)
+{
+    (void)wl_buffer;
+    struct Buffer *buffer = data;
+    buffer->busy = false;
+}
+
+static const struct wl_buffer_listener wl_buffer_listener =
+{
+    .release = &wl_buffer_handle_release
+};
+
+struct Buffer *buffer_create(struct Connection *conn, int width, int height)
+{
+    struct Buffer *buffer = calloc(1, sizeof(struct Buffer));
+    buffer->width = width;
+    buffer->height = height;
+    buffer->scale = bench.outputScale;
+
+    const int stride = width * buffer->scale * 4;
+    const int size = stride * height * buffer->scale;
+    const int fd = create_shm_file(size);
+
+    if (fd < 0)
+        fatal("Failed to create a SHM file of %d bytes.", size);
+
+    buffer->data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (buffer->data == MAP_FAILED)
+        fatal("Failed to map a SHM file of %d bytes.", size);
+
+    struct wl_shm_pool *pool = wl_shm_create_pool(conn->shm, fd, size);
+    buffer->buffer = wl_shm_pool_create_buffer(pool, 0, width * buffer->scale, height * buffer->scale, stride, WL_SHM_FORMAT_ARGB8888);
+    wl_buffer_add_listener(buffer->buffer, &wl_buffer_listener, buffer);
+    wl_shm_pool_destroy(pool);
+    close(fd);
+    return buffer;
+}
+
+void buffer_fill(struct Buffer *buffer, uint32_t argb)
+{
+    buffer_fill_rect(buffer, 0, 0, buffer->width, buffer->height, argb);
+}
+
+void buffer_fill_rect(struct Buffer *buffer, int x, int y, int w, int h, uint32_t argb)
+{
+    const int stride = buffer->width * buffer->scale;
+    const int x1 = x * buffer->scale;
+    const int y1 = y * buffer->scale;
+    const int x2 = (x + w) * buffer->scale;
+    const int y2 = (y + h) * buffer->scale;
+    uint32_t *pixels = (uint32_t*)buffer->data;
+
+    for (int row = y1 < 0 ? 0 : y1; row < y2 && row < buffer->height * buffer->scale; row++)
+        for (int col = x1 < 0 ? 0 : x1; col < x2 && col < stride; col++)
+            pixels[row * stride + col] = argb;
+}
+
+struct Buffer *buffer_pool_acquire(struct Buffer **pool, int count)
+{
+    for (int i = 0; i < count; i++)
+        if (!pool[i]->busy)
+            return pool[i];
+
+    return NULL;
+}
+
+/******************** SURFACES ********************/
+
+static void frame_handle_done(void *data, struct wl_callback *callback, uint32_t ms);
+
+static const struct wl_callback_listener frame_listener =
+{
+    .done = &frame_handle_done
+};
+
+struct Feedback
+{
+    long long int commitUs;
+};
+
+static void feedback_handle_presented(void *data, struct wp_presentation_feedback *feedback,
+                                      uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec,
+                                      uint32_t refresh, uint32_t seq_hi, uint32_t seq_lo, uint32_t flags)
+{
+    (void)refresh; (void)seq_hi; (void)seq_lo; (void)flags;
+    struct Feedback *fb = data;
+    const long long int sec = (long long int)(((uint64_t)tv_sec_hi << 32) | tv_sec_lo);
+    const long long int presentedUs = sec * 1000000 + tv_nsec / 1000;
+
+    if (!bench.finished)
+    {
+        samples_push(&bench.presentationLatencyUs, presentedUs - fb->commitUs);
+        bench.presented++;
+    }
+
+    wp_presentation_feedback_destroy(feedback);
+    free(fb);
+}
+
+static void feedback_handle_discarded(void *data, struct wp_presentation_feedback *feedback)
+{
+    if (!bench.finished)
+        bench.discarded++;
+
+    wp_presentation_feedback_destroy(feedback);
+    free(data);
+}
+
+static const struct wp_presentation_feedback_listener feedback_listener =
+{
+    .sync_output = &noop,
+    .presented = &feedback_handle_presented,
+    .discarded = &feedback_handle_discarded
+};
+
+static void record_frame(struct Surface *surface)
+{
+    const long long int now = now_us(CLOCK_MONOTONIC);
+
+    /* The first callback starts the measurement */
+    if (!bench.started)
+    {
+        bench.started = true;
+        bench.startUs = now;
+    }
+    else
+    {
+        if (surface->lastFrameUs != 0)
+            samples_push(&bench.frameIntervalsUs, now - surface->lastFrameUs);
+
+        bench.frames++;
+    }
+
+    surface->lastFrameUs = now;
+    bench.elapsedUs = now - bench.startUs;
+
+    if (bench.elapsedUs >= (long long int)bench.opts.durationMs * 1000)
+        bench.finished = true;
+}
+
+static void frame_handle_done(void *data, struct wl_callback *callback, uint32_t ms)
+{
+    (void)ms;
+    struct Surface *surface = data;
+    wl_callback_destroy(callback);
+    surface->frameCallback = NULL;
+
+    if (surface->tracked)
+        record_frame(surface);
+
+    if (bench.finished)
+        return;
+
+    surface->onFrame(surface, bench_time_ms());
+    surface_commit(surface);
+}
+
+static void xdg_surface_handle_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial)
+{
+    (void)data;
+    xdg_surface_ack_configure(xdg_surface, serial);
+}
+
+static const struct xdg_surface_listener xdg_surface_listener =
+{
+    .configure = &xdg_surface_handle_configure
+};
+
+static void xdg_toplevel_handle_configure(void *data, struct xdg_toplevel *xdg_toplevel, int32_t w, int32_t h, struct wl_array *states)
+{
+    (void)xdg_toplevel;
+    (void)states;
+    struct Surface *surface = data;
+
+    /* Only maximized toplevels follow the suggested size */
+    if (surface->width != 0 || w <= 0 || h <= 0)
+        return;
+
+    surface->width = w;
+    surface->height = h;
+}
+
+static const struct xdg_toplevel_listener xdg_toplevel_listener =
+{
+    .configure = &xdg_toplevel_handle_configure,
+    .close = &noop
+};
+
+struct Surface *surface_create(struct Connection *conn)
+{
+    struct Surface *surface = calloc(1, sizeof(struct Surface));
+    surface->conn = conn;
+    surface->surface = wl_compositor_create_surface(conn->compositor);
+    wl_surface_set_buffer_scale(surface->surface, bench.outputScale);
+    return surface;
+}
+
+struct Surface *toplevel_create(struct Connection *conn, int width, int height, bool maximized)
+{
+    struct Surface *surface = surface_create(conn);
+    surface->xdg_surface = xdg_wm_base_get_xdg_surface(conn->xdg_wm_base, surface->surface);
+    xdg_surface_add_listener(surface->xdg_surface, &xdg_surface_listener, surface);
+    surface->xdg_toplevel = xdg_surface_get_toplevel(surface->xdg_surface);
+    xdg_toplevel_add_listener(surface->xdg_toplevel, &xdg_toplevel_listener, surface);
+    xdg_toplevel_set_title(surface->xdg_toplevel, "LBenchmark");
+
+    if (maximized)
+        xdg_toplevel_set_maximized(surface->xdg_toplevel);
+    else
+    {
+        surface->width = width;
+        surface->height = height;
+    }
+
+    wl_surface_commit(surface->surface);
+    wl_display_roundtrip(conn->display);
+
+    if (surface->width == 0)
+    {
+        surface->width = bench.outputWidth / bench.outputScale;
+        surface->height = bench.outputHeight / bench.outputScale - 32;
+    }
+
+    return surface;
+}
+
+struct wl_subsurface *subsurface_create(struct Surface *parent, struct Surface *child, bool desync)
+{
+    struct wl_subsurface *subsurface = wl_subcompositor_get_subsurface(parent->conn->subcompositor, child->surface, parent->surface);
+
+    if (desync)
+        wl_subsurface_set_desync(subsurface);
+
+    return subsurface;
+}
+
+void surface_attach(struct Surface *surface, struct Buffer *buffer)
+{
+    buffer->busy = true;
+    wl_surface_attach(surface->surface, buffer->buffer, 0, 0);
+}
+
+void surface_start(struct Surface *surface, SurfaceFrameFunc onFrame)
+{
+    surface->onFrame = onFrame;
+
+    if (surface->tracked)
+        bench.trackedSurfaces++;
+
+    surface_commit(surface);
+}
+
+void surface_commit(struct Surface *surface)
+{
+    if (surface->onFrame)
+    {
+        surface->frameCallback = wl_surface_frame(surface->surface);
+        wl_callback_add_listener(surface->frameCallback, &frame_listener, surface);
+    }
+
+    if (surface->tracked && bench.started && !bench.finished)
+    {
+        bench.commits++;
+
+        if (surface->conn->presentation)
+        {
+            struct Feedback *fb = calloc(1, sizeof(struct Feedback));
+            struct wp_presentation_feedback *feedback = wp_presentation_feedback(surface->conn->presentation, surface->surface);
+            wp_presentation_feedback_add_listener(feedback, &feedback_listener, fb);
+            fb->commitUs = now_us(surface->conn->presentationClock);
+        }
+    }
+
+    wl_surface_commit(surface->surface);
+}
@@ -0,0 +1,125 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <wayland-client.h>
+
+#include "xdg-shell-client-protocol.h"
+#include "presentation-time-client-protocol.h"
+#include "viewporter-client-protocol.h"
+#include "single-pixel-buffer-v1-client-protocol.h"
+
+#define MAX_CONNECTIONS 64
+
+/* Globals bound by a client connection, optional ones may be NULL */
+struct Connection
+{
+    struct wl_display *display;
+    struct wl_registry *registry;
+    struct wl_compositor *compositor;
+    struct wl_subcompositor *subcompositor;
+    struct wl_shm *shm;
+    struct wl_output *output;
+    struct xdg_wm_base *xdg_wm_base;
+    struct wp_presentation *presentation;
+    struct wp_viewporter *viewporter;
+    struct wp_single_pixel_buffer_manager_v1 *single_pixel_buffer_manager;
+    clockid_t presentationClock;
+};
+
+/* ARGB8888 SHM buffer, size in surface coordinates, busy while held by the compositor */
+struct Buffer
+{
+    struct wl_buffer *buffer;
+    unsigned char *data;
+    int width, height, scale;
+    bool busy;
+};
+
+struct Surface;
+
+/* Called before each commit of a surface driven by frame callbacks */
+typedef void (*SurfaceFrameFunc)(struct Surface *surface, double ms);
+
+struct Surface
+{
+    struct Connection *conn;
+    struct wl_surface *surface;
+    struct xdg_surface *xdg_surface;
+    struct xdg_toplevel *xdg_toplevel;
+    struct wl_callback *frameCallback;
+    SurfaceFrameFunc onFrame;
+    void *data;
+    int width, height;
+    long long int lastFrameUs;
+
+    /* Frame callbacks and presentation feedback are included in the results */
+    bool tracked;
+};
+
+struct Samples
+{
+    long long int *values;
+    size_t count, capacity;
+};
+
+struct Options
+{
+    const char *scenario;
+    const char *outputPath;
+    int count;
+    int clients;
+    int durationMs;
+    int compositorPid;
+    unsigned int seed;
+};
+
+struct Bench
+{
+    struct Options opts;
+    struct Connection connections[MAX_CONNECTIONS];
+    int connectionsCount;
+    int outputWidth, outputHeight, outputScale;
+    int trackedSurfaces;
+
+    struct Samples frameIntervalsUs;
+    struct Samples presentationLatencyUs;
+    unsigned long long int frames;
+    unsigned long long int commits;
+    unsigned long long int presented;
+    unsigned long long int discarded;
+    unsigned long long int bufferStalls;
+
+    long long int startUs;
+    long long int elapsedUs;
+    bool started, finished;
+};
+
+extern struct Bench bench;
+
+long long int now_us(clockid_t clock);
+double bench_time_ms(void);
+void fatal(const char *format, ...);
+
+/* Connections */
+struct Connection *connection_create(void);
+void connections_dispatch(int timeoutMs);
+
+/* Buffers */
+struct Buffer *buffer_create(struct Connection *conn, int width, int height);
+void buffer_fill(struct Buffer *buffer, uint32_t argb);
+void buffer_fill_rect(struct Buffer *buffer, int x, int y, int w, int h, uint32_t argb);
+struct Buffer *buffer_pool_acquire(struct Buffer **pool, int count);
+
+/* Surfaces */
+struct Surface *surface_create(struct Connection *conn);
+struct Surface *toplevel_create(struct Connection *conn, int width, int height, bool maximized);
+struct wl_subsurface *subsurface_create(struct Surface *parent, struct Surface *child, bool desync);
+void surface_attach(struct Surface *surface, struct Buffer *buffer);
+void surface_start(struct Surface *surface, SurfaceFrameFunc onFrame);
+void surface_commit(struct Surface *surface);
+
+#endif // BENCH_H
@@ -1,447 +1,210 @@
-#include <bits/time.h>
-#include <stdbool.h>
+#define _POSIX_C_SOURCE 200809L
+#include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/mman.h>
-#include <sys/time.h>
-#include <time.h>
 #include <unistd.h>
-#include <wayland-client.h>
-#include <wayland-client-protocol.h>
 
-#include "shm.h"
-#include "xdg-shell-client-protocol.h"
-
-struct wl_callback_listener wl_callback_listener;
-static void wl_callback_handle_done(void *data, struct wl_callback *callback, uint32_t ms);
-
-static int N;
-static FILE *fp;
-static struct wl_display *display;
-static int outputScale = 1;
-static int childSize = 512;
-
-static struct wl_shm *shm = NULL;
-static struct wl_output *output = NULL;
-static struct wl_subcompositor *subcompositor = NULL;
-static struct wl_compositor *compositor = NULL;
-static struct xdg_wm_base *xdg_wm_base = NULL;
-
-struct wl_region *childRegion;
-
-struct ParentSurface
-{
-    struct wl_region *region;
-    unsigned char *shm_data;
-    struct wl_buffer *buffer;
-    struct wl_surface *surface;
-    struct xdg_surface *xdg_surface;
-    struct xdg_toplevel *xdg_toplevel;
-    int width, height;
-}parent;
-
-static unsigned char *shm_opaque;
-struct wl_buffer *buffer_opaque;
-
-static unsigned char *shm_translucent;
-static struct wl_buffer *buffer_translucent;
-
-struct ChildSurface
-{
-    struct wl_surface *surface;
-    struct wl_subsurface *subsurface;
-    float phaseX;
-    float phaseY;
-    float speed;
-};
-
-static struct ChildSurface *children;
-
-static struct wl_callback *callback = NULL;
-
-struct timespec start, end;
-
-static void noop(){}
-
-static long long int wait_ms = 0;
-static long long int ms = 0;
-static long long int total = 0;
-static int firstCallback = 0;
-static char fname[128];
-
-static int outputW, outputH;
+#include "bench.h"
+#include "scenarios.h"
+#include "stats.h"
+
+/* Give up if the compositor doesn't send any frame callback after this */
+static const int startTimeoutMs = 5000;
+
+static void print_usage(const char *argv0)
+{
+    printf("Usage: %s [options]\n\n", argv0);
+    printf("  -s, --scenario NAME      Workload to run (default: subsurfaces), see --list\n");
+    printf("  -n, --count N            Workload size, its meaning depends on the scenario\n");
+    printf("  -c, --clients N          Client connections used by multi-client scenarios (default: 4)\n");
+    printf("  -d, --duration MS        Measurement duration in milliseconds (default: 10000)\n");
+    printf("  -S, --seed SEED          Seed of the pseudo-random layout (default: 1)\n");
+    printf("  -p, --compositor-pid PID Also report CPU, memory and GPU counters of the compositor process\n");
+    printf("  -o, --output FILE        Write the JSON results to FILE instead of stdout\n");
+    printf("  -l, --list               List the available scenarios\n");
+    printf("  -h, --help               Show this help\n");
+}
 
-static void save()
+static void print_scenarios(void)
 {
-    fprintf(fp, "RESULTS\n");
-    fprintf(fp, "Output Scale: %d\n", outputScale);
-    fprintf(fp, "Maximized Surface Size: %d x %d\n", parent.width, parent.height);
-    fprintf(fp, "Total Frames: %lld\n", total);
-    fprintf(fp, "Milisegundos: %lld\n", ms);
-    fprintf(fp, "FPS: %f\n", (1000.f*(float)total)/(float)ms);
-    fclose(fp);
-    exit(0);
+    for (int i = 0; i < scenariosCount; i++)
+        printf("%-14s %s\n%-14s -n: %s (default: %d)\n\n", scenarios[i].name, scenarios[i].description,
+               "", scenarios[i].countDescription, scenarios[i].defaultCount);
 }
 
-static void wl_callback_handle_done(void *data, struct wl_callback *callback, uint32_t m)
+static void parse_args(int argc, char *argv[])
 {
-    if(firstCallback == 0)
-    {
-        firstCallback = 1;
-        clock_gettime(CLOCK_MONOTONIC_RAW, &start);
-    }
-    else
+    static const struct option longOptions[] =
     {
-        clock_gettime(CLOCK_MONOTONIC_RAW, &end);
-
-        ms = ((end.tv_sec - start.tv_sec) * 1000000000 + (end.tv_nsec - start.tv_nsec)) / 1000000;
+        { "scenario",       required_argument, NULL, 's' },
+        { "count",          required_argument, NULL, 'n' },
+        { "clients",        required_argument, NULL, 'c' },
+        { "duration",       required_argument, NULL, 'd' },
+        { "seed",           required_argument, NULL, 'S' },
+        { "compositor-pid", required_argument, NULL, 'p' },
+        { "output",         required_argument, NULL, 'o' },
+        { "list",           no_argument,       NULL, 'l' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
 
-        if(ms >= wait_ms)
-            save();
+    bench.opts.scenario = "subsurfaces";
+    bench.opts.count = -1;
+    bench.opts.clients = 4;
+    bench.opts.durationMs = 10000;
+    bench.opts.seed = 1;
 
-        float t = ms/50.f;
+    int opt;
 
-        for(int i = 0; i < N; i++)
+    while ((opt = getopt_long(argc, argv, "s:n:c:d:S:p:o:lh", longOptions, NULL)) != -1)
+    {
+        switch (opt)
         {
-            int x = (parent.width-childSize)* (sin(children[i].phaseX+t*children[i].speed)+1)/2;
-            int y = (parent.height-childSize)* (sin(children[i].phaseY+t*children[i].speed)+1)/2;
-            wl_subsurface_set_position(children[i].subsurface, x, y);
-
-            if(i % 2 == 0)
-                wl_surface_set_opaque_region(children[i].surface,childRegion);
-            else
-                wl_surface_set_opaque_region(children[i].surface, NULL);
+        case 's': bench.opts.scenario = optarg; break;
+        case 'n': bench.opts.count = atoi(optarg); break;
+        case 'c': bench.opts.clients = atoi(optarg); break;
+        case 'd': bench.opts.durationMs = atoi(optarg); break;
+        case 'S': bench.opts.seed = (unsigned int)strtoul(optarg, NULL, 10); break;
+        case 'p': bench.opts.compositorPid = atoi(optarg); break;
+        case 'o': bench.opts.outputPath = optarg; break;
+        case 'l': print_scenarios(); exit(EXIT_SUCCESS);
+        case 'h': print_usage(argv[0]); exit(EXIT_SUCCESS);
+        default: print_usage(argv[0]); exit(EXIT_FAILURE);
         }
     }
 
-    unsigned char r = (sinf( (float)ms * 0.0015f ) + 1.f) * 128;
-    unsigned char g = (cosf( (float)ms * 0.0010f ) + 1.f) * 128;
-    unsigned char b = (cosf( (float)ms * 0.0005f ) + 1.f) * 128;
-    unsigned char a = 255;
-
-    for(int i = 0; i < parent.width * outputScale * 4 * 10 * outputScale; i+=4)
-    {
-        parent.shm_data[i] = r;
-        parent.shm_data[i+1] = g;
-        parent.shm_data[i+2] = b;
-        parent.shm_data[i+3] = a;
-    }
-
-    callback = wl_surface_frame(parent.surface);
-    wl_callback_add_listener(callback, &wl_callback_listener, parent.surface);
-    wl_surface_attach(parent.surface, parent.buffer, 0, 0);
-    wl_surface_damage(parent.surface,0,0,parent.width,10);
-    wl_surface_set_opaque_region(parent.surface,parent.region);
-    wl_surface_commit(parent.surface);
-    total++;
-}
-
-struct wl_callback_listener wl_callback_listener =
-{
-    .done = &wl_callback_handle_done
-};
-
-static void xdg_surface_handle_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial)
-{
-    (void)data;
-	xdg_surface_ack_configure(xdg_surface, serial);
-}
-
-static const struct xdg_surface_listener xdg_surface_listener =
-{
-	.configure = xdg_surface_handle_configure,
-};
-
-static void xdg_toplevel_handle_configure(void *data, struct xdg_toplevel *xdg_toplevel, int32_t w, int32_t h, struct wl_array *states)
-{
-    (void)data;
-    (void)xdg_toplevel;
-    (void)states;
-
-    if(w == 0)
-        return;
-
-    parent.width = w;
-    parent.height = h;
-}
-
-static const struct xdg_toplevel_listener xdg_toplevel_listener =
-{
-    .configure = &xdg_toplevel_handle_configure,
-    .close = &noop,
-};
-
-static void wl_output_handle_scale(void *data, struct wl_output *output, int32_t scale)
-{
-    (void)data;
-    (void)output;
-    outputScale = scale;
-}
-
-static void wl_output_handle_mode(void *data,
-                                  struct wl_output *output,
-                                  unsigned int flags,
-                                  int w,
-                                  int h,
-                                  int refresh)
-{
-    (void)data;
-    (void)output;
-    (void)flags;
-    (void)refresh;
-    outputW = w;
-    outputH = h;
-}
-
-static const struct wl_output_listener wl_output_listener =
-{
-    .scale = &wl_output_handle_scale,
-    .description = &noop,
-    .done = &noop,
-    .geometry = &noop,
-    .mode = &wl_output_handle_mode
-};
-
-static void xdg_wm_base_handle_ping(void *data, struct xdg_wm_base *wm, uint32_t serial)
-{
-    (void)data;
-    xdg_wm_base_pong(wm,serial);
-}
-
-static const struct xdg_wm_base_listener xdg_wm_base_listener =
-{
-    .ping = &xdg_wm_base_handle_ping
-};
-
-static void handle_global(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version)
-{
-    (void)data; (void)version;
-
-    if (strcmp(interface, wl_shm_interface.name) == 0)
-    {
-		shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
-    }
-    else if (strcmp(interface, wl_output_interface.name) == 0)
-    {
-        output = wl_registry_bind(registry, name, &wl_output_interface, 3);
-        wl_output_add_listener(output, &wl_output_listener, NULL);
-    }
-    else if (strcmp(interface, wl_compositor_interface.name) == 0)
-    {
-        compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 3);
-    }
-    else if (strcmp(interface, wl_subcompositor_interface.name) == 0)
-    {
-        subcompositor = wl_registry_bind(registry, name, &wl_subcompositor_interface, 1);
-    }
-    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
-    {
-		xdg_wm_base = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
-        xdg_wm_base_add_listener(xdg_wm_base, &xdg_wm_base_listener, NULL);
-	}
-}
-
-static void handle_global_remove(void *data, struct wl_registry *registry, uint32_t name)
-{
-    (void)data;
-    (void)registry;
-    (void)name;
-}
-
-static const struct wl_registry_listener registry_listener =
-{
-	.global = handle_global,
-	.global_remove = handle_global_remove,
-};
-
-static struct wl_buffer *create_buffer(int w, int h)
-{
-    int stride = w * 4;
-    int size = stride * h;
-
-	int fd = create_shm_file(size);
-
-    if (fd < 0)
-		return NULL;
-
-    void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (bench.opts.clients < 1)
+        bench.opts.clients = 1;
 
-    if (data == MAP_FAILED)
-    {
-		close(fd);
-		return NULL;
-	}
-
-	struct wl_shm_pool *pool = wl_shm_create_pool(shm, fd, size);
-    struct wl_buffer *buffer = wl_shm_pool_create_buffer(pool, 0, w, h, stride, WL_SHM_FORMAT_ARGB8888);
-    wl_buffer_set_user_data(buffer, data);
-	wl_shm_pool_destroy(pool);
-
-	return buffer;
+    if (bench.opts.durationMs < 1)
+        fatal("Invalid duration %d.", bench.opts.durationMs);
 }
 
-static void initParent()
+static void write_results(const struct Scenario *scenario, const struct ProcCounters *begin, const struct ProcCounters *end)
 {
-    parent.surface = wl_compositor_create_surface(compositor);
-    parent.xdg_surface = xdg_wm_base_get_xdg_surface(xdg_wm_base, parent.surface);
-    parent.xdg_toplevel = xdg_surface_get_toplevel(parent.xdg_surface);
-
-    xdg_surface_add_listener(parent.xdg_surface, &xdg_surface_listener, NULL);
-    xdg_toplevel_add_listener(parent.xdg_toplevel, &xdg_toplevel_listener, NULL);
-
-    wl_display_roundtrip(display);
-    wl_surface_set_buffer_scale(parent.surface, outputScale);
-    xdg_toplevel_set_maximized(parent.xdg_toplevel);
-    wl_surface_attach(parent.surface, NULL, 0,0);
-    wl_surface_commit(parent.surface);
-
-    wl_display_roundtrip(display);
+    FILE *fp = stdout;
 
-    if (parent.width == 0)
+    if (bench.opts.outputPath)
     {
-        parent.width = outputW/outputScale;
-        parent.height = outputH/outputScale - 32;
-    }
-
-    parent.buffer = create_buffer(parent.width*outputScale, parent.height*outputScale);
-    parent.shm_data = wl_buffer_get_user_data(parent.buffer);
+        fp = fopen(bench.opts.outputPath, "w");
 
-    for(int i = 0; i < parent.width*parent.height*outputScale*outputScale*4; i+=4)
-    {
-        parent.shm_data[i] = 255;
-        parent.shm_data[i+1] = 255;
-        parent.shm_data[i+2] = 255;
-        parent.shm_data[i+3] = 255;
+        if (!fp)
+            fatal("Failed to open %s.", bench.opts.outputPath);
     }
 
-    parent.region = wl_compositor_create_region(compositor);
-    wl_region_add(parent.region,0,0,parent.width,parent.height);
-    wl_surface_set_opaque_region(parent.surface,parent.region);
-
-    wl_surface_attach(parent.surface, parent.buffer, 0, 0);
-    wl_surface_commit(parent.surface);
-    wl_display_roundtrip(display);
-}
-
-void initChildren()
-{
-    children = malloc(sizeof(struct ChildSurface)*N);
-    childRegion = wl_compositor_create_region(compositor);
-    wl_region_add(childRegion,0,0,childSize,childSize);
-    wl_display_roundtrip(display);
-
-    for(int i = 0; i < N; i++)
-    {
-        children[i].phaseX = 6.28f*(float)(rand() % 10000)/10000.f;
-        children[i].phaseY = 6.28f*(float)(rand() % 10000)/10000.f;
-        children[i].speed = 0.01 + 0.1*(float)(rand() % 10000)/10000.f;
-        children[i].surface = wl_compositor_create_surface(compositor);
-        wl_surface_set_buffer_scale(children[i].surface, outputScale);
-        wl_display_roundtrip(display);
-        children[i].subsurface = wl_subcompositor_get_subsurface(subcompositor, children[i].surface, parent.surface);
-        wl_subsurface_set_desync(children[i].subsurface);
-        wl_surface_commit(children[i].surface);
-        wl_display_roundtrip(display);
-        wl_subsurface_set_position(children[i].subsurface, 100, 100);
-        wl_surface_commit(parent.surface);
-        wl_display_roundtrip(display);
-        wl_surface_commit(children[i].surface);
-
-        if(i % 2 == 0)
-        {
-            wl_surface_attach(children[i].surface, buffer_opaque, 0, 0);
-            wl_surface_set_opaque_region(children[i].surface,childRegion);
-        }
-        else
+    const double seconds = (double)bench.elapsedUs / 1000000.0;
+    const struct Summary intervals = samples_summarize(&bench.frameIntervalsUs);
+    const struct Summary latency = samples_summarize(&bench.presentationLatencyUs);
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"scenario\": \"%s\",\n", scenario->name);
+    fprintf(fp, "  \"count\": %d,\n", bench.opts.count);
+    fprintf(fp, "  \"clients\": %d,\n", bench.connectionsCount);
+    fprintf(fp, "  \"seed\": %u,\n", bench.opts.seed);
+    fprintf(fp, "  \"durationMs\": %.1f,\n", (double)bench.elapsedUs / 1000.0);
+    fprintf(fp, "  \"output\": { \"width\": %d, \"height\": %d, \"scale\": %d },\n",
+            bench.outputWidth, bench.outputHeight, bench.outputScale);
+
+    /* FPS is averaged over all the surfaces driven by frame callbacks */
+    fprintf(fp, "  \"frames\": {\n");
+    fprintf(fp, "    \"trackedSurfaces\": %d,\n", bench.trackedSurfaces);
+    fprintf(fp, "    \"callbacks\": %llu,\n", bench.frames);
+    fprintf(fp, "    \"fps\": %.2f,\n", seconds > 0.0 && bench.trackedSurfaces > 0 ? (double)bench.frames / seconds / bench.trackedSurfaces : 0.0);
+    fprintf(fp, "    \"bufferStalls\": %llu,\n", bench.bufferStalls);
+    fprintf(fp, "    ");
+    summary_write_json(fp, "intervalUs", &intervals);
+    fprintf(fp, "\n  },\n");
+
+    fprintf(fp, "  \"presentation\": {\n");
+    fprintf(fp, "    \"supported\": %s,\n", bench.connections[0].presentation ? "true" : "false");
+    fprintf(fp, "    \"commits\": %llu,\n", bench.commits);
+    fprintf(fp, "    \"presented\": %llu,\n", bench.presented);
+    fprintf(fp, "    \"discarded\": %llu,\n", bench.discarded);
+    fprintf(fp, "    ");
+    summary_write_json(fp, "latencyUs", &latency);
+    fprintf(fp, "\n  }");
+
+    if (begin->valid && end->valid)
+    {
+        const double ticksPerSecond = (double)sysconf(_SC_CLK_TCK);
+        const double cpuMs = (double)(end->cpuTicks - begin->cpuTicks) * 1000.0 / ticksPerSecond;
+
+        fprintf(fp, ",\n  \"compositor\": {\n");
+        fprintf(fp, "    \"pid\": %d,\n", bench.opts.compositorPid);
+        fprintf(fp, "    \"cpuMs\": %.1f,\n", cpuMs);
+        fprintf(fp, "    \"cpuPercent\": %.2f,\n", seconds > 0.0 ? cpuMs / 10.0 / seconds : 0.0);
+        fprintf(fp, "    \"voluntaryCtxSwitches\": %llu,\n", end->voluntaryCtxSwitches - begin->voluntaryCtxSwitches);
+        fprintf(fp, "    \"involuntaryCtxSwitches\": %llu,\n", end->involuntaryCtxSwitches - begin->involuntaryCtxSwitches);
+        fprintf(fp, "    \"maxRssKiB\": %llu", end->maxRssKiB);
+
+        if (begin->gpuValid && end->gpuValid && end->gpuEngineNs >= begin->gpuEngineNs)
         {
-            wl_surface_attach(children[i].surface, buffer_translucent, 0, 0);
-            wl_surface_set_opaque_region(children[i].surface, NULL);
-
+            const double gpuMs = (double)(end->gpuEngineNs - begin->gpuEngineNs) / 1000000.0;
+            fprintf(fp, ",\n    \"gpuMs\": %.1f,\n", gpuMs);
+            fprintf(fp, "    \"gpuPercent\": %.2f", seconds > 0.0 ? gpuMs / 10.0 / seconds : 0.0);
         }
 
-        wl_surface_commit(children[i].surface);
-        wl_surface_commit(parent.surface);
-        wl_display_roundtrip(display);
+        fprintf(fp, "\n  }");
     }
+
+    fprintf(fp, "\n}\n");
+
+    if (fp != stdout)
+        fclose(fp);
 }
 
 int main(int argc, char *argv[])
 {
-    N = atoi(argv[1]);
-    wait_ms = atoi(argv[2]);
-    sprintf(fname, "%s_N_%d_MS_%d.txt", argv[3], N, atoi(argv[2]));
-    srand(atoi(argv[4]));
-
-    fp = fopen(fname, "w");
-    display = wl_display_connect(NULL);
-	struct wl_registry *registry = wl_display_get_registry(display);
-	wl_registry_add_listener(registry, &registry_listener, NULL);
-	wl_display_roundtrip(display);
-    wl_display_roundtrip(display);
-
-    if (shm == NULL || compositor == NULL || xdg_wm_base == NULL || subcompositor == NULL)
-		return EXIT_FAILURE;
-
-    initParent();
-
-    buffer_opaque = create_buffer(childSize*outputScale, childSize*outputScale);
-    shm_opaque = wl_buffer_get_user_data(buffer_opaque);
-    for(int i = 0; i < childSize*outputScale*childSize*outputScale*4; i+=4)
-    {
-        shm_opaque[i] = 0;
-        shm_opaque[i+1] = 0;
-        shm_opaque[i+2] = 255;
-        shm_opaque[i+3] = 255;
-    }
+    parse_args(argc, argv);
 
-    wl_display_roundtrip(display);
+    const struct Scenario *scenario = scenario_find(bench.opts.scenario);
 
-    buffer_translucent = create_buffer(childSize*outputScale, childSize*outputScale);
-    shm_translucent = wl_buffer_get_user_data(buffer_translucent);
-    for(int i = 0; i < childSize*outputScale*childSize*outputScale*4; i+=4)
-    {
-        shm_translucent[i] = 255;
-        shm_translucent[i+1] = 0;
-        shm_translucent[i+2] = 0;
-        shm_translucent[i+3] = 100;
-    }
+    if (!scenario)
+        fatal("Unknown scenario '%s', use --list to see the available ones.", bench.opts.scenario);
 
-    wl_display_roundtrip(display);
+    if (bench.opts.count < 0)
+        bench.opts.count = scenario->defaultCount;
 
-    initChildren();
+    srand(bench.opts.seed);
+    bench.outputScale = 1;
+    scenario->init();
 
-    wl_display_roundtrip(display);
+    if (bench.trackedSurfaces == 0)
+        fatal("The scenario didn't start any surface.");
 
-    callback = wl_surface_frame(parent.surface);
-    wl_callback_add_listener(callback, &wl_callback_listener, parent.surface);
-    wl_surface_damage(parent.surface, 0,0,parent.width,parent.height);
-    wl_surface_commit(parent.surface);
+    struct ProcCounters begin = { 0 }, end = { 0 };
+    const long long int setupUs = now_us(CLOCK_MONOTONIC);
 
-    for(int i = 0; i < N; i++)
+    while (!bench.finished)
     {
+        if (!bench.started)
+        {
+            if (now_us(CLOCK_MONOTONIC) - setupUs > (long long int)startTimeoutMs * 1000)
+                fatal("No frame callbacks received in %d ms.", startTimeoutMs);
 
-        wl_subsurface_set_position(children[i].subsurface, 0, 0);
+            connections_dispatch(100);
 
-        if(i % 2 == 0)
-        {
-            wl_surface_attach(children[i].surface, buffer_opaque, 0, 0);
-            wl_surface_damage(children[i].surface, 0, 0, childSize, childSize);
+            if (bench.started)
+                proc_counters_read(bench.opts.compositorPid, &begin);
+
+            continue;
         }
-        else
+
+        const long long int remainingUs = bench.startUs + (long long int)bench.opts.durationMs * 1000 - now_us(CLOCK_MONOTONIC);
+
+        /* Frame callbacks may stop if every surface is hidden */
+        if (remainingUs <= 0)
         {
-            wl_surface_attach(children[i].surface, buffer_translucent, 0, 0);
-            wl_surface_damage(children[i].surface, 0, 0, childSize, childSize);
+            bench.finished = true;
+            bench.elapsedUs = (long long int)bench.opts.durationMs * 1000;
+            break;
         }
 
-        wl_surface_commit(children[i].surface);
+        connections_dispatch((int)(remainingUs / 1000) + 1);
     }
 
-
-    while (wl_display_dispatch(display) != -1)
-    {
-		// This space intentionally left blank
-	}
-
-	return EXIT_SUCCESS;
+    proc_counters_read(bench.opts.compositorPid, &end);
+    write_results(scenario, &begin, &end);
+    return EXIT_SUCCESS;
 }
@@ -0,0 +1,662 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "scenarios.h"
+
+static void noop() {}
+
+static int random_int(int max)
+{
+    return max <= 0 ? 0 : rand() % max;
+}
+
+static float random_float(void)
+{
+    return (float)(rand() % 10000) / 10000.f;
+}
+
+static uint32_t argb(unsigned char a, unsigned char r, unsigned char g, unsigned char b)
+{
+    return ((uint32_t)a << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+static void set_opaque(struct Surface *surface, int w, int h)
+{
+    struct wl_region *region = wl_compositor_create_region(surface->conn->compositor);
+    wl_region_add(region, 0, 0, w, h);
+    wl_surface_set_opaque_region(surface->surface, region);
+    wl_region_destroy(region);
+}
+
+/* Tracked maximized toplevel with a white opaque buffer */
+static struct Surface *create_main_toplevel(struct Buffer **buffer)
+{
+    struct Connection *conn = connection_create();
+    struct Surface *toplevel = toplevel_create(conn, 0, 0, true);
+    toplevel->tracked = true;
+    *buffer = buffer_create(conn, toplevel->width, toplevel->height);
+    buffer_fill(*buffer, 0xFFFFFFFF);
+    set_opaque(toplevel, toplevel->width, toplevel->height);
+    surface_attach(toplevel, *buffer);
+    wl_surface_damage(toplevel->surface, 0, 0, toplevel->width, toplevel->height);
+    wl_surface_commit(toplevel->surface);
+    wl_display_roundtrip(conn->display);
+    return toplevel;
+}
+
+/******************** SUBSURFACES ********************/
+
+/* N moving SHM subsurfaces damaged only once plus a strip of the parent damaged every frame */
+
+static const int childSize = 512;
+
+static struct
+{
+    struct Buffer *parentBuffer;
+    struct Surface **children;
+    struct wl_subsurface **subsurfaces;
+    float *phaseX, *phaseY, *speed;
+} subsurfaces;
+
+static void subsurfaces_frame(struct Surface *parent, double ms)
+{
+    const float t = (float)ms / 50.f;
+    const int n = bench.opts.count;
+
+    for (int i = 0; i < n; i++)
+    {
+        const int x = (parent->width - childSize) * (sinf(subsurfaces.phaseX[i] + t * subsurfaces.speed[i]) + 1.f) / 2.f;
+        const int y = (parent->height - childSize) * (sinf(subsurfaces.phaseY[i] + t * subsurfaces.speed[i]) + 1.f) / 2.f;
+        wl_subsurface_set_position(subsurfaces.subsurfaces[i], x, y);
+    }
+
+    const unsigned char r = (sinf((float)ms * 0.0015f) + 1.f) * 127.f;
+    const unsigned char g = (cosf((float)ms * 0.0010f) + 1.f) * 127.f;
+    const unsigned char b = (cosf((float)ms * 0.0005f) + 1.f) * 127.f;
+    buffer_fill_rect(subsurfaces.parentBuffer, 0, 0, parent->width, 10, argb(255, r, g, b));
+    surface_attach(parent, subsurfaces.parentBuffer);
+    wl_surface_damage(parent->surface, 0, 0, parent->width, 10);
+}
+
+static void subsurfaces_init(void)
+{
+    const int n = bench.opts.count;
+    struct Surface *parent = create_main_toplevel(&subsurfaces.parentBuffer);
+    struct Connection *conn = parent->conn;
+
+    struct Buffer *opaque = buffer_create(conn, childSize, childSize);
+    buffer_fill(opaque, argb(255, 0, 0, 255));
+    struct Buffer *translucent = buffer_create(conn, childSize, childSize);
+    buffer_fill(translucent, argb(100, 100, 0, 0));
+
+    subsurfaces.children = calloc(n, sizeof(struct Surface*));
+    subsurfaces.subsurfaces = calloc(n, sizeof(struct wl_subsurface*));
+    subsurfaces.phaseX = calloc(n, sizeof(float));
+    subsurfaces.phaseY = calloc(n, sizeof(float));
+    subsurfaces.speed = calloc(n, sizeof(float));
+
+    for (int i = 0; i < n; i++)
+    {
+        subsurfaces.phaseX[i] = 6.28f * random_float();
+        subsurfaces.phaseY[i] = 6.28f * random_float();
+        subsurfaces.speed[i] = 0.01f + 0.1f * random_float();
+
+        struct Surface *child = surface_create(conn);
+        subsurfaces.children[i] = child;
+        subsurfaces.subsurfaces[i] = subsurface_create(parent, child, true);
+
+        if (i % 2 == 0)
+        {
+            set_opaque(child, childSize, childSize);
+            surface_attach(child, opaque);
+        }
+        else
+            surface_attach(child, translucent);
+
+        wl_surface_damage(child->surface, 0, 0, childSize, childSize);
+        wl_surface_commit(child->surface);
+    }
+
+    surface_start(parent, &subsurfaces_frame);
+}
+
+/******************** TOPLEVELS ********************/
+
+/* Many small toplevels from several client connections, each damaging a moving patch every frame */
+
+static const int toplevelWidth = 320;
+static const int toplevelHeight = 240;
+static const int patchSize = 32;
+
+struct Window
+{
+    struct Buffer *buffer;
+    float phase;
+    int patchX, patchY;
+};
+
+static void toplevels_frame(struct Surface *toplevel, double ms)
+{
+    struct Window *window = toplevel->data;
+    const float t = (float)ms * 0.002f + window->phase;
+
+    /* Restore the previous patch */
+    buffer_fill_rect(window->buffer, window->patchX, window->patchY, patchSize, patchSize, 0xFFFFFFFF);
+    wl_surface_damage(toplevel->surface, window->patchX, window->patchY, patchSize, patchSize);
+
+    window->patchX = (toplevelWidth - patchSize) * (sinf(t) + 1.f) / 2.f;
+    window->patchY = (toplevelHeight - patchSize) * (cosf(t * 1.3f) + 1.f) / 2.f;
+    buffer_fill_rect(window->buffer, window->patchX, window->patchY, patchSize, patchSize, argb(255, 255 * window->phase / 6.28f, 0, 128));
+    wl_surface_damage(toplevel->surface, window->patchX, window->patchY, patchSize, patchSize);
+    surface_attach(toplevel, window->buffer);
+}
+
+static void toplevels_init(void)
+{
+    const int n = bench.opts.count;
+    int clients = bench.opts.clients;
+
+    if (clients > n)
+        clients = n;
+
+    if (clients > MAX_CONNECTIONS)
+        clients = MAX_CONNECTIONS;
+
+    struct Connection *conns[MAX_CONNECTIONS];
+
+    for (int i = 0; i < clients; i++)
+        conns[i] = connection_create();
+
+    for (int i = 0; i < n; i++)
+    {
+        struct Connection *conn = conns[i % clients];
+        struct Surface *toplevel = toplevel_create(conn, toplevelWidth, toplevelHeight, false);
+        struct Window *window = calloc(1, sizeof(struct Window));
+        window->buffer = buffer_create(conn, toplevelWidth, toplevelHeight);
+        window->phase = 6.28f * random_float();
+        buffer_fill(window->buffer, 0xFFFFFFFF);
+        set_opaque(toplevel, toplevelWidth, toplevelHeight);
+        surface_attach(toplevel, window->buffer);
+        wl_surface_damage(toplevel->surface, 0, 0, toplevelWidth, toplevelHeight);
+        toplevel->data = window;
+        toplevel->tracked = true;
+        surface_start(toplevel, &toplevels_frame);
+    }
+}
+
+/******************** POPUPS ********************/
+
+/* N popups destroyed and created again every frame */
+
+static const int popupWidth = 128;
+static const int popupHeight = 96;
+
+static struct
+{
+    struct Buffer *parentBuffer;
+    struct Buffer *popupBuffer;
+    struct Surface **popups;
+    struct xdg_popup **roles;
+} popups;
+
+static void popup_handle_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial)
+{
+    struct Surface *popup = data;
+    xdg_surface_ack_configure(xdg_surface, serial);
+    surface_attach(popup, popups.popupBuffer);
+    wl_surface_damage(popup->surface, 0, 0, popupWidth, popupHeight);
+    wl_surface_commit(popup->surface);
+}
+
+static const struct xdg_surface_listener popup_xdg_surface_listener =
+{
+    .configure = &popup_handle_configure
+};
+
+static const struct xdg_popup_listener popup_listener =
+{
+    .configure = &noop,
+    .popup_done = &noop
+};
+
+static void popups_frame(struct Surface *parent, double ms)
+{
+    (void)ms;
+    const int n = bench.opts.count;
+
+    /* Destroy the topmost first */
+    for (int i = n - 1; i >= 0; i--)
+    {
+        if (!popups.popups[i])
+            continue;
+
+        xdg_popup_destroy(popups.roles[i]);
+        xdg_surface_destroy(popups.popups[i]->xdg_surface);
+        wl_surface_destroy(popups.popups[i]->surface);
+        free(popups.popups[i]);
+        popups.popups[i] = NULL;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        struct Surface *popup = surface_create(parent->conn);
+        popup->xdg_surface = xdg_wm_base_get_xdg_surface(parent->conn->xdg_wm_base, popup->surface);
+        xdg_surface_add_listener(popup->xdg_surface, &popup_xdg_surface_listener, popup);
+
+        struct xdg_positioner *positioner = xdg_wm_base_create_positioner(parent->conn->xdg_wm_base);
+        xdg_positioner_set_size(positioner, popupWidth, popupHeight);
+        xdg_positioner_set_anchor_rect(positioner, random_int(parent->width - 1), random_int(parent->height - 1), 1, 1);
+        xdg_positioner_set_anchor(positioner, XDG_POSITIONER_ANCHOR_TOP_LEFT);
+        xdg_positioner_set_gravity(positioner, XDG_POSITIONER_GRAVITY_BOTTOM_RIGHT);
+        xdg_positioner_set_constraint_adjustment(positioner,
+            XDG_POSITIONER_CONSTRAINT_ADJUSTMENT_SLIDE_X | XDG_POSITIONER_CONSTRAINT_ADJUSTMENT_SLIDE_Y);
+
+        popups.roles[i] = xdg_surface_get_popup(popup->xdg_surface, parent->xdg_surface, positioner);
+        xdg_popup_add_listener(popups.roles[i], &popup_listener, popup);
+        xdg_positioner_destroy(positioner);
+        wl_surface_commit(popup->surface);
+        popups.popups[i] = popup;
+    }
+}
+
+static void popups_init(void)
+{
+    const int n = bench.opts.count;
+    struct Surface *parent = create_main_toplevel(&popups.parentBuffer);
+    popups.popupBuffer = buffer_create(parent->conn, popupWidth, popupHeight);
+    buffer_fill(popups.popupBuffer, argb(255, 40, 40, 60));
+    popups.popups = calloc(n, sizeof(struct Surface*));
+    popups.roles = calloc(n, sizeof(struct xdg_popup*));
+    surface_start(parent, &popups_frame);
+}
+
+/******************** DAMAGE ********************/
+
+/* N small rects damaged at random positions every frame */
+
+static const int damageSize = 8;
+
+static struct
+{
+    struct Buffer *buffer;
+} damage;
+
+static void damage_frame(struct Surface *surface, double ms)
+{
+    (void)ms;
+
+    for (int i = 0; i < bench.opts.count; i++)
+    {
+        const int x = random_int(surface->width - damageSize);
+        const int y = random_int(surface->height - damageSize);
+        buffer_fill_rect(damage.buffer, x, y, damageSize, damageSize, argb(255, rand(), rand(), rand()));
+        wl_surface_damage(surface->surface, x, y, damageSize, damageSize);
+    }
+
+    surface_attach(surface, damage.buffer);
+}
+
+static void damage_init(void)
+{
+    struct Surface *surface = create_main_toplevel(&damage.buffer);
+    surface_start(surface, &damage_frame);
+}
+
+/******************** VIDEO ********************/
+
+/* N toplevels whose entire SHM content changes every frame, rendered into a triple buffered pool */
+
+#define VIDEO_BUFFERS 3
+
+struct Video
+{
+    struct Buffer *pool[VIDEO_BUFFERS];
+    unsigned int frame;
+};
+
+static void video_frame(struct Surface *surface, double ms)
+{
+    (void)ms;
+    struct Video *video = surface->data;
+    struct Buffer *buffer = buffer_pool_acquire(video->pool, VIDEO_BUFFERS);
+
+    /* All buffers are still held by the compositor, the frame is dropped */
+    if (!buffer)
+    {
+        bench.bufferStalls++;
+        return;
+    }
+
+    const int w = buffer->width * buffer->scale;
+    const int h = buffer->height * buffer->scale;
+    uint32_t *pixels = (uint32_t*)buffer->data;
+
+    for (int y = 0; y < h; y++)
+    {
+        const uint32_t row = argb(255, y + video->frame, y * 2 - video->frame, video->frame * 3);
+
+        for (int x = 0; x < w; x++)
+            pixels[y * w + x] = row ^ (uint32_t)(x + video->frame);
+    }
+
+    video->frame++;
+    surface_attach(surface, buffer);
+    wl_surface_damage(surface->surface, 0, 0, buffer->width, buffer->height);
+}
+
+static void video_init(void)
+{
+    struct Connection *conn = connection_create();
+    int w = 1280, h = 720;
+
+    if (bench.outputWidth > 0 && w > bench.outputWidth / bench.outputScale)
+        w = bench.outputWidth / bench.outputScale;
+
+    if (bench.outputHeight > 0 && h > bench.outputHeight / bench.outputScale)
+        h = bench.outputHeight / bench.outputScale;
+
+    for (int i = 0; i < bench.opts.count; i++)
+    {
+        struct Surface *surface = toplevel_create(conn, w, h, false);
+        struct Video *video = calloc(1, sizeof(struct Video));
+
+        for (int j = 0; j < VIDEO_BUFFERS; j++)
+            video->pool[j] = buffer_create(conn, w, h);
+
+        surface->data = video;
+        surface->tracked = true;
+        set_opaque(surface, w, h);
+        video_frame(surface, 0.0);
+        surface_start(surface, &video_frame);
+    }
+}
+
+/******************** SINGLE PIXEL ********************/
+
+/* A single-pixel background plus N translucent single-pixel tiles, all changing color every frame */
+
+static struct
+{
+    struct Surface **tiles;
+} singlePixel;
+
+static void single_pixel_buffer_handle_release(void *data, struct wl_buffer *buffer)
+{
+    (void)data;
+    wl_buffer_destroy(buffer);
+}
+
+static const struct wl_buffer_listener single_pixel_buffer_listener =
+{
+    .release = &single_pixel_buffer_handle_release
+};
+
+static void single_pixel_attach(struct Surface *surface, float r, float g, float b, float a)
+{
+    struct wl_buffer *buffer = wp_single_pixel_buffer_manager_v1_create_u32_rgba_buffer(
+        surface->conn->single_pixel_buffer_manager,
+        (uint32_t)(r * (float)UINT32_MAX),
+        (uint32_t)(g * (float)UINT32_MAX),
+        (uint32_t)(b * (float)UINT32_MAX),
+        (uint32_t)(a * (float)UINT32_MAX));
+    wl_buffer_add_listener(buffer, &single_pixel_buffer_listener, NULL);
+    wl_surface_attach(surface->surface, buffer, 0, 0);
+    wl_surface_damage(surface->surface, 0, 0, INT32_MAX, INT32_MAX);
+}
+
+static struct Surface *single_pixel_surface(struct Connection *conn, int w, int h)
+{
+    struct Surface *surface = surface_create(conn);
+    wl_surface_set_buffer_scale(surface->surface, 1);
+    struct wp_viewport *viewport = wp_viewporter_get_viewport(conn->viewporter, surface->surface);
+    wp_viewport_set_destination(viewport, w, h);
+    surface->width = w;
+    surface->height = h;
+    return surface;
+}
+
+static void single_pixel_frame(struct Surface *background, double ms)
+{
+    const float t = (float)ms * 0.001f;
+    single_pixel_attach(background, (sinf(t) + 1.f) / 2.f, (cosf(t) + 1.f) / 2.f, 0.5f, 1.f);
+
+    for (int i = 0; i < bench.opts.count; i++)
+    {
+        const float phase = t + (float)i;
+        single_pixel_attach(singlePixel.tiles[i], (cosf(phase) + 1.f) / 2.f, 0.2f, (sinf(phase) + 1.f) / 2.f, 0.5f);
+        wl_surface_commit(singlePixel.tiles[i]->surface);
+    }
+}
+
+static void single_pixel_init(void)
+{
+    struct Connection *conn = connection_create();
+
+    if (!conn->single_pixel_buffer_manager || !conn->viewporter)
+        fatal("The single-pixel scenario requires wp_single_pixel_buffer_manager_v1 and wp_viewporter.");
+
+    struct Surface *background = toplevel_create(conn, 0, 0, true);
+    wl_surface_set_buffer_scale(background->surface, 1);
+    struct wp_viewport *viewport = wp_viewporter_get_viewport(conn->viewporter, background->surface);
+    wp_viewport_set_destination(viewport, background->width, background->height);
+    set_opaque(background, background->width, background->height);
+    background->tracked = true;
+
+    const int n = bench.opts.count;
+    const int columns = (int)ceilf(sqrtf((float)n));
+    const int tileW = columns > 0 ? background->width / columns : 1;
+    const int tileH = columns > 0 ? background->height / columns : 1;
+    singlePixel.tiles = calloc(n, sizeof(struct Surface*));
+
+    for (int i = 0; i < n; i++)
+    {
+        struct Surface *tile = single_pixel_surface(conn, tileW > 1 ? tileW - 1 : 1, tileH > 1 ? tileH - 1 : 1);
+        struct wl_subsurface *subsurface = subsurface_create(background, tile, true);
+        wl_subsurface_set_position(subsurface, (i % columns) * tileW, (i / columns) * tileH);
+        singlePixel.tiles[i] = tile;
+    }
+
+    single_pixel_frame(background, 0.0);
+    surface_start(background, &single_pixel_frame);
+}
+
+/******************** VIEWPORTER ********************/
+
+/* N subsurfaces cropped and scaled with wp_viewport differently every frame */
+
+static const int viewportBufferSize = 256;
+
+static struct
+{
+    struct Buffer *parentBuffer;
+    struct Surface **children;
+    struct wl_subsurface **subsurfaces;
+    struct wp_viewport **viewports;
+    float *phase;
+} viewporter;
+
+static void viewporter_frame(struct Surface *parent, double ms)
+{
+    const float t = (float)ms * 0.001f;
+
+    for (int i = 0; i < bench.opts.count; i++)
+    {
+        const float phase = t + viewporter.phase[i];
+        const int crop = (viewportBufferSize / 4) * (sinf(phase) + 1.f) / 2.f;
+        const int size = 64 + 448 * (cosf(phase * 0.7f) + 1.f) / 2.f;
+        const int x = (parent->width - size) * (sinf(phase * 0.3f) + 1.f) / 2.f;
+        const int y = (parent->height - size) * (cosf(phase * 0.4f) + 1.f) / 2.f;
+
+        wp_viewport_set_source(viewporter.viewports[i],
+                               wl_fixed_from_int(crop), wl_fixed_from_int(crop),
+                               wl_fixed_from_int(viewportBufferSize - 2 * crop), wl_fixed_from_int(viewportBufferSize - 2 * crop));
+        wp_viewport_set_destination(viewporter.viewports[i], size, size);
+        wl_surface_commit(viewporter.children[i]->surface);
+        wl_subsurface_set_position(viewporter.subsurfaces[i], x < 0 ? 0 : x, y < 0 ? 0 : y);
+    }
+}
+
+static void viewporter_init(void)
+{
+    const int n = bench.opts.count;
+    struct Surface *parent = create_main_toplevel(&viewporter.parentBuffer);
+    struct Connection *conn = parent->conn;
+
+    if (!conn->viewporter)
+        fatal("The viewporter scenario requires wp_viewporter.");
+
+    /* Checkerboard, so scaling artifacts and filtering cost are visible */
+    struct Buffer *buffer = buffer_create(conn, viewportBufferSize, viewportBufferSize);
+
+    for (int y = 0; y < viewportBufferSize; y += 16)
+        for (int x = 0; x < viewportBufferSize; x += 16)
+            buffer_fill_rect(buffer, x, y, 16, 16, ((x + y) / 16) % 2 ? argb(255, 255, 128, 0) : argb(255, 20, 20, 20));
+
+    viewporter.children = calloc(n, sizeof(struct Surface*));
+    viewporter.subsurfaces = calloc(n, sizeof(struct wl_subsurface*));
+    viewporter.viewports = calloc(n, sizeof(struct wp_viewport*));
+    viewporter.phase = calloc(n, sizeof(float));
+
+    for (int i = 0; i < n; i++)
+    {
+        struct Surface *child = surface_create(conn);
+        viewporter.children[i] = child;
+        viewporter.subsurfaces[i] = subsurface_create(parent, child, true);
+        viewporter.viewports[i] = wp_viewporter_get_viewport(conn->viewporter, child->surface);
+        viewporter.phase[i] = 6.28f * random_float();
+        set_opaque(child, viewportBufferSize, viewportBufferSize);
+        surface_attach(child, buffer);
+        wl_surface_damage(child->surface, 0, 0, viewportBufferSize, viewportBufferSize);
+    }
+
+    viewporter_frame(parent, 0.0);
+    surface_start(parent, &viewporter_frame);
+}
+
+/******************** REORDER ********************/
+
+/* N overlapping static subsurfaces restacked every frame */
+
+static const int reorderSize = 128;
+
+static struct
+{
+    struct Buffer *parentBuffer;
+    struct Surface **children;
+    struct wl_subsurface **subsurfaces;
+} reorder;
+
+static void reorder_frame(struct Surface *parent, double ms)
+{
+    (void)parent;
+    (void)ms;
+    const int n = bench.opts.count;
+
+    if (n < 2)
+        return;
+
+    for (int k = 0; k < n / 4 + 1; k++)
+    {
+        const int i = random_int(n);
+        const int j = random_int(n);
+
+        if (i == j)
+            continue;
+
+        if (k % 2 == 0)
+            wl_subsurface_place_above(reorder.subsurfaces[i], reorder.children[j]->surface);
+        else
+            wl_subsurface_place_below(reorder.subsurfaces[i], reorder.children[j]->surface);
+    }
+}
+
+static void reorder_init(void)
+{
+    const int n = bench.opts.count;
+    struct Surface *parent = create_main_toplevel(&reorder.parentBuffer);
+    struct Connection *conn = parent->conn;
+
+    struct Buffer *opaque = buffer_create(conn, reorderSize, reorderSize);
+    buffer_fill(opaque, argb(255, 0, 120, 255));
+    struct Buffer *translucent = buffer_create(conn, reorderSize, reorderSize);
+    buffer_fill(translucent, argb(128, 128, 0, 64));
+
+    reorder.children = calloc(n, sizeof(struct Surface*));
+    reorder.subsurfaces = calloc(n, sizeof(struct wl_subsurface*));
+
+    /* Keep them clustered so most restacks change visible content */
+    const int areaW = parent->width / 3;
+    const int areaH = parent->height / 3;
+
+    for (int i = 0; i < n; i++)
+    {
+        struct Surface *child = surface_create(conn);
+        reorder.children[i] = child;
+        reorder.subsurfaces[i] = subsurface_create(parent, child, false);
+        wl_subsurface_set_position(reorder.subsurfaces[i], areaW + random_int(areaW - reorderSize), areaH + random_int(areaH - reorderSize));
+
+        if (i % 2 == 0)
+        {
+            set_opaque(child, reorderSize, reorderSize);
+            surface_attach(child, opaque);
+        }
+        else
+            surface_attach(child, translucent);
+
+        wl_surface_damage(child->surface, 0, 0, reorderSize, reorderSize);
+        wl_surface_commit(child->surface);
+    }
+
+    surface_start(parent, &reorder_frame);
+}
+
+/******************** TABLE ********************/
+
+const struct Scenario scenarios[] =
+{
+    {
+        "subsurfaces", "Maximized toplevel with moving SHM subsurfaces and a small strip damaged every frame",
+        "moving subsurfaces", 10, &subsurfaces_init
+    },
+    {
+        "toplevels", "Small toplevels spread across -c client connections, each damaging a moving patch every frame",
+        "toplevels", 16, &toplevels_init
+    },
+    {
+        "popups", "Maximized toplevel destroying and creating xdg_popups every frame",
+        "popups per frame", 8, &popups_init
+    },
+    {
+        "damage", "Maximized toplevel damaging many small random rects every frame",
+        "8x8 damage rects per frame", 64, &damage_init
+    },
+    {
+        "video", "Toplevels whose entire SHM content changes every frame, triple buffered",
+        "video toplevels", 1, &video_init
+    },
+    {
+        "single-pixel", "Single-pixel buffer background and tiles scaled with wp_viewport, recolored every frame",
+        "tiles", 16, &single_pixel_init
+    },
+    {
+        "viewporter", "Subsurfaces cropped and scaled with wp_viewport differently every frame",
+        "scaled subsurfaces", 16, &viewporter_init
+    },
+    {
+        "reorder", "Overlapping subsurfaces restacked with place_above/below every frame",
+        "subsurfaces", 32, &reorder_init
+    }
+};
+
+const int scenariosCount = sizeof(scenarios) / sizeof(scenarios[0]);
+
+const struct Scenario *scenario_find(const char *name)
+{
+    for (int i = 0; i < scenariosCount; i++)
+        if (strcmp(scenarios[i].name, name) == 0)
+            return &scenarios[i];
+
+    return NULL;
+}
@@ -0,0 +1,22 @@
+#ifndef SCENARIOS_H
+#define SCENARIOS_H
+
+struct Scenario
+{
+    const char *name;
+    const char *description;
+
+    /* Meaning of the -n option */
+    const char *countDescription;
+    int defaultCount;
+
+    /* Creates the surfaces and starts the ones driven by frame callbacks */
+    void (*init)(void);
+};
+
+extern const struct Scenario scenarios[];
+extern const int scenariosCount;
+
+const struct Scenario *scenario_find(const char *name);
+
+#endif // SCENARIOS_H
@@ -0,0 +1,205 @@
+#define _DEFAULT_SOURCE
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stats.h"
+
+void samples_push(struct Samples *samples, long long int value)
+{
+    if (samples->count == samples->capacity)
+    {
+        samples->capacity = samples->capacity == 0 ? 1024 : samples->capacity * 2;
+        samples->values = realloc(samples->values, sizeof(long long int) * samples->capacity);
+
+        if (!samples->values)
+            fatal("Failed to allocate samples.");
+    }
+
+    samples->values[samples->count++] = value;
+}
+
+static int compare_samples(const void *a, const void *b)
+{
+    const long long int x = *(const long long int*)a;
+    const long long int y = *(const long long int*)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static long long int percentile(const long long int *sorted, size_t count, int p)
+{
+    size_t rank = (count * p + 99) / 100;
+
+    if (rank == 0)
+        rank = 1;
+
+    return sorted[rank - 1];
+}
+
+struct Summary samples_summarize(const struct Samples *samples)
+{
+    struct Summary summary = { 0 };
+
+    if (samples->count == 0)
+        return summary;
+
+    long long int *sorted = malloc(sizeof(long long int) * samples->count);
+
+    if (!sorted)
+        fatal("Failed to allocate samples.");
+
+    memcpy(sorted, samples->values, sizeof(long long int) * samples->count);
+    qsort(sorted, samples->count, sizeof(long long int), compare_samples);
+
+    double sum = 0.0;
+
+    for (size_t i = 0; i < samples->count; i++)
+        sum += (double)sorted[i];
+
+    summary.count = samples->count;
+    summary.mean = sum / (double)samples->count;
+    summary.min = sorted[0];
+    summary.p50 = percentile(sorted, samples->count, 50);
+    summary.p90 = percentile(sorted, samples->count, 90);
+    summary.p99 = percentile(sorted, samples->count, 99);
+    summary.max = sorted[samples->count - 1];
+    free(sorted);
+    return summary;
+}
+
+void summary_write_json(FILE *fp, const char *name, const struct Summary *summary)
+{
+    fprintf(fp, "\"%s\": { \"count\": %zu, \"mean\": %.1f, \"min\": %lld, \"p50\": %lld, \"p90\": %lld, \"p99\": %lld, \"max\": %lld }",
+            name, summary->count, summary->mean, summary->min, summary->p50, summary->p90, summary->p99, summary->max);
+}
+
+static bool read_stat(int pid, struct ProcCounters *counters)
+{
+    char path[64];
+    char line[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *fp = fopen(path, "r");
+
+    if (!fp)
+        return false;
+
+    const bool ok = fgets(line, sizeof(line), fp) != NULL;
+    fclose(fp);
+
+    if (!ok)
+        return false;
+
+    /* The command name may contain spaces, fields are counted after it */
+    char *fields = strrchr(line, ')');
+
+    if (!fields)
+        return false;
+
+    unsigned long long int utime, stime;
+
+    if (sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2)
+        return false;
+
+    counters->cpuTicks = utime + stime;
+    return true;
+}
+
+static void read_status(int pid, struct ProcCounters *counters)
+{
+    char path[64];
+    char line[256];
+    snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    FILE *fp = fopen(path, "r");
+
+    if (!fp)
+        return;
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        sscanf(line, "voluntary_ctxt_switches: %llu", &counters->voluntaryCtxSwitches);
+        sscanf(line, "nonvoluntary_ctxt_switches: %llu", &counters->involuntaryCtxSwitches);
+        sscanf(line, "VmHWM: %llu", &counters->maxRssKiB);
+    }
+
+    fclose(fp);
+}
+
+static void read_drm_fdinfo(int pid, struct ProcCounters *counters)
+{
+    char path[PATH_MAX];
+    char line[256];
+    snprintf(path, sizeof(path), "/proc/%d/fdinfo", pid);
+    DIR *dir = opendir(path);
+
+    if (!dir)
+        return;
+
+    /* Duplicated fds of the same DRM client report the same usage */
+    unsigned long long int clients[64];
+    size_t clientsCount = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        snprintf(path, sizeof(path), "/proc/%d/fdinfo/%s", pid, entry->d_name);
+        FILE *fp = fopen(path, "r");
+
+        if (!fp)
+            continue;
+
+        unsigned long long int clientId = 0, engineNs = 0, value;
+        bool isDrmClient = false;
+
+        while (fgets(line, sizeof(line), fp))
+        {
+            if (sscanf(line, "drm-client-id: %llu", &clientId) == 1)
+                isDrmClient = true;
+            else if (strncmp(line, "drm-engine-", 11) == 0 && strncmp(line, "drm-engine-capacity-", 20) != 0)
+            {
+                const char *colon = strchr(line, ':');
+
+                if (colon && sscanf(colon + 1, " %llu ns", &value) == 1)
+                    engineNs += value;
+            }
+        }
+
+        fclose(fp);
+
+        if (!isDrmClient)
+            continue;
+
+        bool seen = false;
+
+        for (size_t i = 0; i < clientsCount; i++)
+            if (clients[i] == clientId)
+                seen = true;
+
+        if (seen || clientsCount == sizeof(clients) / sizeof(clients[0]))
+            continue;
+
+        clients[clientsCount++] = clientId;
+        counters->gpuEngineNs += engineNs;
+        counters->gpuValid = true;
+    }
+
+    closedir(dir);
+}
+
+bool proc_counters_read(int pid, struct ProcCounters *counters)
+{
+    memset(counters, 0, sizeof(*counters));
+
+    if (pid <= 0 || !read_stat(pid, counters))
+        return false;
+
+    read_status(pid, counters);
+    read_drm_fdinfo(pid, counters);
+    counters->valid = true;
+    return true;
+}
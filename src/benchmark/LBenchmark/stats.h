@@ -0,0 +1,36 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "bench.h"
+
+struct Summary
+{
+    size_t count;
+    double mean;
+    long long int min, p50, p90, p99, max;
+};
+
+/* Counters of the compositor process read from /proc */
+struct ProcCounters
+{
+    bool valid;
+    unsigned long long int cpuTicks;
+    unsigned long long int voluntaryCtxSwitches;
+    unsigned long long int involuntaryCtxSwitches;
+    unsigned long long int maxRssKiB;
+
+    /* Sum of the drm-engine-* times of all its DRM clients, see the kernel drm-usage-stats docs */
+    bool gpuValid;
+    unsigned long long int gpuEngineNs;
+};
+
+void samples_push(struct Samples *samples, long long int value);
+struct Summary samples_summarize(const struct Samples *samples);
+void summary_write_json(FILE *fp, const char *name, const struct Summary *summary);
+
+bool proc_counters_read(int pid, struct ProcCounters *counters);
+
+#endif // STATS_H
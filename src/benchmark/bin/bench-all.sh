@@ -1,6 +1,6 @@
 #!/bin/bash
 
-sudo rm *.txt
+rm -f *.json
 
 # Update this array if want to try different number of surfaces
 array=($(seq 1 1 50))
@@ -21,6 +21,6 @@ do
 	done
 	
 	mkdir $iter
-	sudo chmod 777 *.txt
-	mv *.txt ./$iter/
+	chmod 666 *.json
+	mv *.json ./$iter/
 done
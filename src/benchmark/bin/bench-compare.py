@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+# Compares two directories created by bench-scenarios.sh and fails if any metric regressed
+# usage: bench-compare.py <baseline dir> <candidate dir> [tolerance % (default 5)]
+
+import json
+import os
+import sys
+
+# (path, higher is better)
+METRICS = [
+    (('frames', 'fps'), True),
+    (('frames', 'intervalUs', 'p99'), False),
+    (('presentation', 'latencyUs', 'p50'), False),
+    (('presentation', 'latencyUs', 'p99'), False),
+    (('compositor', 'cpuPercent'), False),
+    (('compositor', 'gpuPercent'), False),
+    (('compositor', 'maxRssKiB'), False),
+]
+
+def get(data, path):
+    for key in path:
+        if not isinstance(data, dict) or key not in data:
+            return None
+        data = data[key]
+    return data
+
+def main():
+    if len(sys.argv) < 3:
+        print('usage: bench-compare.py <baseline dir> <candidate dir> [tolerance %]')
+        return 2
+
+    baseline, candidate = sys.argv[1], sys.argv[2]
+    tolerance = float(sys.argv[3]) if len(sys.argv) > 3 else 5.0
+    regressions = 0
+
+    for name in sorted(os.listdir(baseline)):
+        if not name.endswith('.json') or not os.path.exists(os.path.join(candidate, name)):
+            continue
+
+        with open(os.path.join(baseline, name)) as f:
+            old = json.load(f)
+
+        with open(os.path.join(candidate, name)) as f:
+            new = json.load(f)
+
+        print(name[:-5])
+
+        for path, higherIsBetter in METRICS:
+            a, b = get(old, path), get(new, path)
+
+            # Metrics with no samples are reported as 0
+            if a is None or b is None or a == 0:
+                continue
+
+            change = (b - a) * 100.0 / a
+            regressed = change < -tolerance if higherIsBetter else change > tolerance
+            regressions += regressed
+            print('  {:<28} {:>12.2f} {:>12.2f} {:>+8.1f}%{}'.format('.'.join(path), a, b, change, '  REGRESSION' if regressed else ''))
+
+    return 1 if regressions else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
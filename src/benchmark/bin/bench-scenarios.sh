@@ -0,0 +1,26 @@
+#!/bin/bash
+# exec <compositor command> <results dir> [milliseconds] [seed]
+# Runs every LBenchmark scenario against the compositor and stores one JSON file per scenario
+
+COMPOSITOR=$1
+DIR=$2
+MS=${3:-10000}
+SEED=${4:-1}
+
+if [ -z "$COMPOSITOR" ] || [ -z "$DIR" ]; then
+    echo "Usage: $0 <compositor command> <results dir> [milliseconds] [seed]"
+    exit 1
+fi
+
+mkdir -p $DIR
+
+for scenario in $(./LBenchmark --list | grep -v '^ ' | awk 'NF { print $1 }')
+do
+    $COMPOSITOR &
+    export COM_PID=$!
+    taskset -cp 0 $COM_PID
+    sleep 2
+    ./LBenchmark --scenario $scenario --duration $MS --seed $SEED --compositor-pid $COM_PID --output $DIR/$scenario.json
+    kill -9 $COM_PID
+    sleep 2
+done
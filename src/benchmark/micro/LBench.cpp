@@ -0,0 +1,121 @@
+#include <LBench.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct LBenchResult
+{
+    std::string name;
+    UInt64 iterations;
+    Float64 medianNs;
+    Float64 minNs;
+    Float64 maxNs;
+};
+
+static std::string _filter;
+static UInt32 _samples { 9 };
+static UInt32 _minTimeMs { 10 };
+static bool _json { false };
+static std::vector<LBenchResult> _results;
+
+static void printUsage(const char *argv0)
+{
+    printf("Usage: %s [options]\n\n", argv0);
+    printf("  --filter TEXT    Only run benchmarks whose name contains TEXT\n");
+    printf("  --samples N      Timed samples per benchmark (default: 9)\n");
+    printf("  --min-time MS    Minimum duration of each sample in milliseconds (default: 10)\n");
+    printf("  --json           Print the results as JSON instead of a table\n");
+    printf("  --help           Show this help\n");
+}
+
+void LBenchInit(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue { i + 1 < argc };
+
+        if (strcmp(argv[i], "--filter") == 0 && hasValue)
+            _filter = argv[++i];
+        else if (strcmp(argv[i], "--samples") == 0 && hasValue)
+            _samples = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue)
+            _minTimeMs = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--json") == 0)
+            _json = true;
+        else if (strcmp(argv[i], "--help") == 0)
+        {
+            printUsage(argv[0]);
+            exit(EXIT_SUCCESS);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!_json)
+        printf("%-48s %14s %12s %12s %12s\n", "benchmark", "iterations", "median ns", "min ns", "max ns");
+}
+
+static Float64 timeNs(const std::function<void(UInt64)> &body, UInt64 iterations)
+{
+    const auto begin { std::chrono::steady_clock::now() };
+    body(iterations);
+    const auto end { std::chrono::steady_clock::now() };
+    return Float64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+}
+
+void LBenchRun(const std::string &name, const std::function<void(UInt64 iterations)> &body)
+{
+    if (!_filter.empty() && name.find(_filter) == std::string::npos)
+        return;
+
+    // Calibration, also warms up caches and the allocator
+    const Float64 minTimeNs { Float64(_minTimeMs) * 1000000.0 };
+    UInt64 iterations { 1 };
+
+    while (timeNs(body, iterations) < minTimeNs && iterations < (UInt64(1) << 40))
+        iterations *= 2;
+
+    std::vector<Float64> samples;
+    samples.reserve(_samples);
+
+    for (UInt32 i = 0; i < _samples; i++)
+        samples.push_back(timeNs(body, iterations) / Float64(iterations));
+
+    std::sort(samples.begin(), samples.end());
+
+    LBenchResult &res { _results.emplace_back() };
+    res.name = name;
+    res.iterations = iterations;
+    res.medianNs = samples[samples.size() / 2];
+    res.minNs = samples.front();
+    res.maxNs = samples.back();
+
+    if (!_json)
+    {
+        printf("%-48s %14llu %12.1f %12.1f %12.1f\n", name.c_str(), (unsigned long long)iterations, res.medianNs, res.minNs, res.maxNs);
+        fflush(stdout);
+    }
+}
+
+int LBenchFinish()
+{
+    if (!_json)
+        return EXIT_SUCCESS;
+
+    printf("{\n  \"samples\": %u,\n  \"minTimeMs\": %u,\n  \"benchmarks\": [", _samples, _minTimeMs);
+
+    for (size_t i = 0; i < _results.size(); i++)
+    {
+        const LBenchResult &res { _results[i] };
+        printf("%s\n    { \"name\": \"%s\", \"iterations\": %llu, \"medianNs\": %.1f, \"minNs\": %.1f, \"maxNs\": %.1f }",
+               i == 0 ? "" : ",", res.name.c_str(), (unsigned long long)res.iterations, res.medianNs, res.minNs, res.maxNs);
+    }
+
+    printf("\n  ]\n}\n");
+    return EXIT_SUCCESS;
+}
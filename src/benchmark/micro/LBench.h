@@ -0,0 +1,52 @@
+#ifndef LBENCH_H
+#define LBENCH_H
+
+#include <LNamespaces.h>
+#include <LRect.h>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Louvre;
+
+/* Parses --filter, --samples, --min-time and --json */
+void LBenchInit(int argc, char *argv[]);
+
+/*
+ * Measures body(iterations). The iterations count is doubled until a single call takes at least
+ * --min-time ms, then --samples calls are timed and the median and minimum ns per iteration reported.
+ * Benchmarks whose name doesn't contain the --filter substring are skipped.
+ */
+void LBenchRun(const std::string &name, const std::function<void(UInt64 iterations)> &body);
+
+/* Writes the JSON report if requested, returns the process exit code */
+int LBenchFinish();
+
+/* Prevents the compiler from discarding a value computed inside a benchmark */
+template <class T>
+inline void LBenchKeep(const T &value) noexcept
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/* Same rects on every run and machine, std::mt19937 output is fully specified */
+inline std::vector<LRect> LBenchRects(UInt32 count, UInt32 seed, const LSize &area, Int32 maxSize)
+{
+    std::mt19937 gen { seed };
+    std::vector<LRect> rects;
+    rects.reserve(count);
+
+    for (UInt32 i = 0; i < count; i++)
+    {
+        const Int32 w { 1 + Int32(gen() % UInt32(maxSize)) };
+        const Int32 h { 1 + Int32(gen() % UInt32(maxSize)) };
+        const Int32 x { Int32(gen() % UInt32(area.w() - w)) };
+        const Int32 y { Int32(gen() % UInt32(area.h() - h)) };
+        rects.emplace_back(x, y, w, h);
+    }
+
+    return rects;
+}
+
+#endif // LBENCH_H
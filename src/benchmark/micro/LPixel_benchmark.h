@@ -0,0 +1,31 @@
+#ifndef LPIXEL_BENCHMARK_H
+#define LPIXEL_BENCHMARK_H
+
+#include <LBench.h>
+#include <private/LTexturePrivate.h>
+
+using namespace Louvre;
+
+/* RGBA <-> BGRA conversion used by the image loader and the hardware cursor readback */
+void LPixel_run_benchmarks()
+{
+    for (const LSize &size : { LSize(64, 64), LSize(256, 256), LSize(1920, 1080) })
+    {
+        std::vector<UChar8> pixels(size.area() * 4);
+        std::mt19937 gen { UInt32(size.area()) };
+
+        for (UChar8 &byte : pixels)
+            byte = gen() & 0xFF;
+
+        LBenchRun("LTexturePrivate::swapRedBlue/" + std::to_string(size.w()) + "x" + std::to_string(size.h()), [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LTexture::LTexturePrivate::swapRedBlue(pixels.data(), size.area());
+                LBenchKeep(pixels.data());
+            }
+        });
+    }
+}
+
+#endif // LPIXEL_BENCHMARK_H
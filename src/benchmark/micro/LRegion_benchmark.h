@@ -0,0 +1,138 @@
+#ifndef LREGION_BENCHMARK_H
+#define LREGION_BENCHMARK_H
+
+#include <LBench.h>
+#include <LRegion.h>
+
+using namespace Louvre;
+
+static LRegion LRegion_benchmark_region(UInt32 rectsCount, UInt32 seed)
+{
+    LRegion region;
+
+    for (const LRect &rect : LBenchRects(rectsCount, seed, LSize(1920, 1080), 256))
+        region.addRect(rect);
+
+    return region;
+}
+
+/* Box counts ranging from a few damaged widgets to a busy multi-window frame */
+void LRegion_run_benchmarks()
+{
+    for (UInt32 count : { 16u, 64u, 256u })
+    {
+        const std::string suffix { "/" + std::to_string(count) };
+        const std::vector<LRect> rects { LBenchRects(count, count, LSize(1920, 1080), 256) };
+        const LRegion a { LRegion_benchmark_region(count, count) };
+        const LRegion b { LRegion_benchmark_region(count, count + 1) };
+        const std::vector<LRect> points { LBenchRects(64, count + 2, LSize(1920, 1080), 1) };
+
+        LBenchRun("LRegion::addRect" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region;
+
+                for (const LRect &rect : rects)
+                    region.addRect(rect);
+
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::copy" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::addRegion" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                region.addRegion(b);
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::subtractRegion" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                region.subtractRegion(b);
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::intersectRegion" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                region.intersectRegion(b);
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::clip" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                region.clip(LRect(480, 270, 960, 540));
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::expand" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                LRegion region { a };
+                region.expand(8);
+                LBenchKeep(region);
+            }
+        });
+
+        LBenchRun("LRegion::offset" + suffix, [&](UInt64 iterations)
+        {
+            LRegion region { a };
+
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                region.offset(i & 1 ? LPoint(-1, -1) : LPoint(1, 1));
+                LBenchKeep(region);
+            }
+        });
+
+        // 64 lookups per iteration
+        LBenchRun("LRegion::containsPoint" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+                for (const LRect &point : points)
+                    LBenchKeep(a.containsPoint(point.pos()));
+        });
+
+        LBenchRun("LRegion::boxes" + suffix, [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                Int32 n;
+                const LBox *boxes { a.boxes(&n) };
+                Int64 area { 0 };
+
+                for (Int32 j = 0; j < n; j++)
+                    area += Int64(boxes[j].x2 - boxes[j].x1) * Int64(boxes[j].y2 - boxes[j].y1);
+
+                LBenchKeep(area);
+            }
+        });
+    }
+}
+
+#endif // LREGION_BENCHMARK_H
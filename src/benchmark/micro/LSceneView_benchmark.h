@@ -0,0 +1,92 @@
+#ifndef LSCENEVIEW_BENCHMARK_H
+#define LSCENEVIEW_BENCHMARK_H
+
+#include <LBench.h>
+#include <LSceneView.h>
+#include <LLayerView.h>
+#include <LSolidColorView.h>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+using namespace Louvre;
+
+namespace Louvre
+{
+    /* Runs the damage pass of LSceneView::render(), which doesn't need a painter */
+    class LSceneViewBenchmark
+    {
+    public:
+        static void calcDamage(LSceneView &scene) noexcept
+        {
+            scene.m_currentThreadData.reset(&scene.m_sceneThreadsMap[std::this_thread::get_id()]);
+            scene.calcDamage(*scene.m_currentThreadData, nullptr);
+        }
+    };
+}
+
+/* A 1080p scene with a layer per "window" holding overlapping opaque and translucent views */
+struct LSceneView_benchmark_tree
+{
+    LSceneView_benchmark_tree(UInt32 viewsCount) : scene(LSize(1920, 1080), 1.f)
+    {
+        const UInt32 layersCount { std::max(1u, viewsCount / 16) };
+        const std::vector<LRect> rects { LBenchRects(viewsCount, viewsCount, LSize(1920, 1080), 400) };
+
+        for (UInt32 i = 0; i < layersCount; i++)
+            layers.emplace_back(std::make_unique<LLayerView>(&scene));
+
+        for (UInt32 i = 0; i < viewsCount; i++)
+        {
+            auto &view { views.emplace_back(std::make_unique<LSolidColorView>(1.f, 1.f, 1.f, i % 4 == 0 ? 0.5f : 1.f, layers[i % layersCount].get())) };
+            view->setPos(rects[i].pos());
+            view->setSize(rects[i].size());
+        }
+
+        // Settle the initial full damage
+        LSceneViewBenchmark::calcDamage(scene);
+    }
+
+    LSceneView scene;
+    std::vector<std::unique_ptr<LLayerView>> layers;
+    std::vector<std::unique_ptr<LSolidColorView>> views;
+};
+
+void LSceneView_run_benchmarks()
+{
+    for (UInt32 count : { 64u, 256u, 1024u })
+    {
+        const std::string suffix { "/" + std::to_string(count) };
+
+        {
+            LSceneView_benchmark_tree tree { count };
+
+            LBenchRun("LSceneView::calcDamage static" + suffix, [&](UInt64 iterations)
+            {
+                for (UInt64 i = 0; i < iterations; i++)
+                    LSceneViewBenchmark::calcDamage(tree.scene);
+            });
+        }
+
+        // A fraction of the views (or all of them) move by one pixel per frame
+        for (UInt32 step : { 8u, 1u })
+        {
+            LSceneView_benchmark_tree tree { count };
+
+            LBenchRun("LSceneView::calcDamage moving 1/" + std::to_string(step) + suffix, [&](UInt64 iterations)
+            {
+                for (UInt64 i = 0; i < iterations; i++)
+                {
+                    const Int32 dx { i & 1 ? -1 : 1 };
+
+                    for (size_t j = 0; j < tree.views.size(); j += step)
+                        tree.views[j]->setPos(tree.views[j]->pos() + LPoint(dx, 0));
+
+                    LSceneViewBenchmark::calcDamage(tree.scene);
+                }
+            });
+        }
+    }
+}
+
+#endif // LSCENEVIEW_BENCHMARK_H
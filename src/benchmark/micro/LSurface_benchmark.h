@@ -0,0 +1,31 @@
+#ifndef LSURFACE_BENCHMARK_H
+#define LSURFACE_BENCHMARK_H
+
+#include <LBench.h>
+#include <private/LSurfacePrivate.h>
+
+using namespace Louvre;
+
+/* Damage rects committed by a client, counts around LOUVRE_MAX_DAMAGE_RECTS collapse into the extents */
+void LSurface_run_benchmarks()
+{
+    for (UInt32 count : { 8u, 64u, UInt32(LOUVRE_MAX_DAMAGE_RECTS), 1024u })
+    {
+        const std::vector<LRect> damage { LBenchRects(count, count, LSize(1920, 1080), 64) };
+        std::vector<LRect> vec;
+        vec.reserve(damage.size());
+
+        // Includes refilling the vector, which is cheap compared with the simplification
+        LBenchRun("LSurfacePrivate::simplifyDamage/" + std::to_string(count), [&](UInt64 iterations)
+        {
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                vec.assign(damage.begin(), damage.end());
+                LSurface::LSurfacePrivate::simplifyDamage(vec);
+                LBenchKeep(vec.data());
+            }
+        });
+    }
+}
+
+#endif // LSURFACE_BENCHMARK_H
@@ -0,0 +1,79 @@
+#ifndef LWEAK_BENCHMARK_H
+#define LWEAK_BENCHMARK_H
+
+#include <LBench.h>
+#include <LWeak.h>
+#include <LObject.h>
+#include <array>
+#include <memory>
+
+using namespace Louvre;
+
+class LObjectBenchmark : public LObject {};
+
+void LWeak_run_benchmarks()
+{
+    LObjectBenchmark object;
+
+    LBenchRun("LWeak::create+destroy", [&](UInt64 iterations)
+    {
+        for (UInt64 i = 0; i < iterations; i++)
+        {
+            LWeak<LObjectBenchmark> weak { &object };
+            LBenchKeep(weak);
+        }
+    });
+
+    // Many refs to the same object created and destroyed out of order, as views and surfaces do
+    LBenchRun("LWeak::reset churn/64", [&](UInt64 iterations)
+    {
+        std::array<LWeak<LObjectBenchmark>, 64> weaks;
+
+        for (UInt64 i = 0; i < iterations; i++)
+        {
+            const size_t index { size_t((i * 37) % weaks.size()) };
+            weaks[index].reset(weaks[index] ? nullptr : &object);
+            LBenchKeep(weaks[index]);
+        }
+    });
+
+    LBenchRun("LWeak::copy", [&](UInt64 iterations)
+    {
+        const LWeak<LObjectBenchmark> weak { &object };
+
+        for (UInt64 i = 0; i < iterations; i++)
+        {
+            LWeak<LObjectBenchmark> copy { weak };
+            LBenchKeep(copy);
+        }
+    });
+
+    LBenchRun("LWeak::get", [&](UInt64 iterations)
+    {
+        const LWeak<LObjectBenchmark> weak { &object };
+
+        for (UInt64 i = 0; i < iterations; i++)
+            LBenchKeep(weak.get());
+    });
+
+    for (UInt32 count : { 0u, 1u, 16u })
+    {
+        LBenchRun("LObject::destroy with refs/" + std::to_string(count), [&](UInt64 iterations)
+        {
+            std::vector<LWeak<LObjectBenchmark>> weaks(count);
+
+            for (UInt64 i = 0; i < iterations; i++)
+            {
+                auto *obj { new LObjectBenchmark() };
+
+                for (auto &weak : weaks)
+                    weak.reset(obj);
+
+                delete obj;
+                LBenchKeep(weaks);
+            }
+        });
+    }
+}
+
+#endif // LWEAK_BENCHMARK_H
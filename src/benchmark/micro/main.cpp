@@ -0,0 +1,24 @@
+#include <LCompositor.h>
+#include <LBench.h>
+
+using namespace Louvre;
+
+#include "LRegion_benchmark.h"
+#include "LWeak_benchmark.h"
+#include "LSceneView_benchmark.h"
+#include "LSurface_benchmark.h"
+#include "LPixel_benchmark.h"
+
+int main(int argc, char *argv[])
+{
+    LBenchInit(argc, argv);
+
+    LCompositor compositor;
+    LRegion_run_benchmarks();
+    LWeak_run_benchmarks();
+    LSceneView_run_benchmarks();
+    LSurface_run_benchmarks();
+    LPixel_run_benchmarks();
+
+    return LBenchFinish();
+}
@@ -63,6 +63,7 @@ void LCompositor::removeGlobal(LGlobal *global) noexcept
         return;
 
     global->m_removed = true;
+    imp()->hasRemovedGlobals = true;
     wl_global_remove(global->m_global);
 }
 
@@ -98,6 +99,15 @@ LCompositor::LCompositor() noexcept : LPRIVATE_INIT_UNIQUE(LCompositor)
     imp()->eglQueryWaylandBufferWL = (PFNEGLQUERYWAYLANDBUFFERWL) eglGetProcAddress ("eglQueryWaylandBufferWL");
     imp()->glEGLImageTargetRenderbufferStorageOES = (PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC) eglGetProcAddress ("glEGLImageTargetRenderbufferStorageOES");
     imp()->glEGLImageTargetTexture2DOES = (PFNGLEGLIMAGETARGETTEXTURE2DOESPROC) eglGetProcAddress ("glEGLImageTargetTexture2DOES");
+    imp()->glGenQueriesEXT = (PFNGLGENQUERIESEXTPROC) eglGetProcAddress ("glGenQueriesEXT");
+    imp()->glDeleteQueriesEXT = (PFNGLDELETEQUERIESEXTPROC) eglGetProcAddress ("glDeleteQueriesEXT");
+    imp()->glBeginQueryEXT = (PFNGLBEGINQUERYEXTPROC) eglGetProcAddress ("glBeginQueryEXT");
+    imp()->glEndQueryEXT = (PFNGLENDQUERYEXTPROC) eglGetProcAddress ("glEndQueryEXT");
+    imp()->glGetQueryObjectuivEXT = (PFNGLGETQUERYOBJECTUIVEXTPROC) eglGetProcAddress ("glGetQueryObjectuivEXT");
+    imp()->glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC) eglGetProcAddress ("glGetQueryObjectui64vEXT");
+    imp()->eglCreateSyncKHR = (PFNEGLCREATESYNCKHRPROC) eglGetProcAddress ("eglCreateSyncKHR");
+    imp()->eglClientWaitSyncKHR = (PFNEGLCLIENTWAITSYNCKHRPROC) eglGetProcAddress ("eglClientWaitSyncKHR");
+    imp()->eglDestroySyncKHR = (PFNEGLDESTROYSYNCKHRPROC) eglGetProcAddress ("eglDestroySyncKHR");
 
 
     imp()->defaultAssetsPath = LOUVRE_DEFAULT_ASSETS_PATH;
@@ -261,16 +271,21 @@ Int32 LCompositor::processLoop(Int32 msTimeout)
     if (!seat()->enabled())
         msTimeout = 100;
 
-    epoll_event events[4];
+    epoll_event events[LEV_COUNT];
 
     Int32 nEvents = epoll_wait(imp()->epollFd,
                          events,
-                         4,
+                         LEV_COUNT,
                          msTimeout);
 
     imp()->lock();
+    imp()->loopCounters.wakeups++;
     seat()->setIsUserIdleHint(true);
-    imp()->sendPresentationTime();
+
+    // Only after a page flip, rendering threads also send it before painting
+    if (imp()->hasUnhandledPresentationTime.exchange(false))
+        imp()->sendPresentationTime();
+
     imp()->processRemovedGlobals();
 
     /* In certain older libseat versions, a POLLIN event may not be generated
@@ -289,52 +304,77 @@ Int32 LCompositor::processLoop(Int32 msTimeout)
         imp()->inputBackend->backendForceUpdate();
     }
 
-    bool flush { false };
+    bool ready[LEV_COUNT] { false };
 
     for (Int32 i = 0; i < nEvents; i++)
-    {
-        // Backend + User
-        if (events[i].data.fd == imp()->events[LEV_AUX].data.fd)
-        {
-            if (seat()->enabled())
+        for (Int32 j = 0; j < LEV_COUNT; j++)
+            if (events[i].data.fd == imp()->events[j].data.fd)
             {
-                wl_event_loop_dispatch(imp()->auxEventLoop, 0);
-                flush = true;
+                ready[j] = true;
+                break;
             }
-        }
-        // Wayland
-        else if (events[i].data.fd == imp()->events[LEV_WAYLAND].data.fd)
-        {
-            if (seat()->enabled())
-            {
-                wl_event_loop_dispatch(imp()->waylandEventLoop, 0);
-                flush = true;
-            }
-        }
-        // Event fd
-        else if (events[i].data.fd == imp()->events[LEV_UNLOCK].data.fd)
+
+    if (nEvents <= 0)
+        imp()->loopCounters.idleWakeups++;
+
+    bool flush { false };
+
+    // Sources are handled by priority regardless of the order epoll reported them
+
+    // Event fd
+    if (ready[LEV_UNLOCK])
+    {
+        UInt64 eventValue;
+        ssize_t n = read(imp()->events[LEV_UNLOCK].data.fd, &eventValue, sizeof(eventValue));
+        L_UNUSED(n);
+        imp()->pollUnlocked = false;
+        imp()->loopCounters.unlockEvents++;
+    }
+
+    if (ready[LEV_LIBSEAT])
+    {
+        seat()->imp()->dispatchSeat();
+        imp()->loopCounters.libseatDispatches++;
+    }
+
+    if (seat()->enabled())
+    {
+        // Backend + User (input events before client requests)
+        if (ready[LEV_AUX])
         {
-            UInt64 eventValue;
-            ssize_t n = read(imp()->events[0].data.fd, &eventValue, sizeof(eventValue));
-            L_UNUSED(n);
-            imp()->pollUnlocked = false;
+            wl_event_loop_dispatch(imp()->auxEventLoop, 0);
+            imp()->loopCounters.auxDispatches++;
+            flush = true;
         }
-        else if (events[i].data.fd == imp()->events[LEV_LIBSEAT].data.fd)
+
+        // Wayland
+        if (ready[LEV_WAYLAND])
         {
-            seat()->imp()->dispatchSeat();
+            wl_event_loop_dispatch(imp()->waylandEventLoop, 0);
+            imp()->loopCounters.waylandDispatches++;
+            flush = true;
         }
     }
 
+    // Requested by rendering threads when a frame is about to start, includes the events just dispatched
+    if (imp()->pendingPointerEventsFlush.exchange(false))
+        seat()->imp()->flushPendingPointerEvents();
+
+    imp()->removeUnusedDeferredCommitsLogger();
+    imp()->notifyOrderChanges();
+    imp()->notifyExclusiveZones();
+
     if (seat()->enabled())
     {
         if (!seat()->isUserIdleHint())
             for (const auto *idleListener : seat()->idleListeners())
                 idleListener->resetTimer();
 
-        if (flush)
+        if (flush || imp()->pendingClientsFlush)
         {
             cursor()->imp()->textureUpdate();
             flushClients();
+            imp()->loopCounters.flushes++;
         }
 
         imp()->destroyPendingRenderBuffers(nullptr);
@@ -400,6 +440,48 @@ Int32 LCompositor::processLoop(Int32 msTimeout)
     return 1;
 }
 
+const LCompositor::LoopCounters &LCompositor::loopCounters() const noexcept
+{
+    return imp()->loopCounters;
+}
+
+void LCompositor::resetLoopCounters() noexcept
+{
+    imp()->loopCounters = LoopCounters();
+}
+
+void LCompositor::setHiddenSurfacesFrameRate(UInt32 hz) noexcept
+{
+    imp()->hiddenSurfacesFrameRate = std::min(hz, 1000u);
+
+    if (hz == 0)
+    {
+        if (imp()->hiddenSurfacesFrameTimer)
+            imp()->hiddenSurfacesFrameTimer->cancel();
+    }
+    else
+        imp()->scheduleHiddenSurfacesFrames();
+}
+
+UInt32 LCompositor::hiddenSurfacesFrameRate() const noexcept
+{
+    return imp()->hiddenSurfacesFrameRate;
+}
+
+void LCompositor::enableDMABufCommitQueue(bool enabled) noexcept
+{
+    imp()->dmaBufCommitQueueEnabled = enabled;
+
+    if (!enabled)
+        while (!imp()->deferredCommitSurfaces.empty())
+            imp()->deferredCommitSurfaces.front()->imp()->applyDeferredCommit();
+}
+
+bool LCompositor::dmaBufCommitQueueEnabled() const noexcept
+{
+    return imp()->dmaBufCommitQueueEnabled;
+}
+
 Int32 LCompositor::fd() const noexcept
 {
     return imp()->epollFd;
@@ -591,8 +673,12 @@ EGLContext LCompositor::eglContext() noexcept
 
 void LCompositor::flushClients() noexcept
 {
+    compositor()->imp()->pendingClientsFlush = false;
     compositor()->imp()->sendPendingConfigurations();
     wl_display_flush_clients(LCompositor::display());
+
+    if (seat()->imp()->pointerLatencyTracing)
+        seat()->imp()->tracePointerLatencyFlush();
 }
 
 LClient *LCompositor::getClientFromNativeResource(const wl_client *client) noexcept
@@ -97,6 +97,93 @@ public:
      */
     Int32 processLoop(Int32 msTimeout);
 
+    /**
+     * @brief Main event loop counters.
+     *
+     * Accumulated statistics about processLoop() wakeups and the event sources dispatched on each of them.
+     *
+     * @see loopCounters()
+     */
+    struct LoopCounters
+    {
+        /// Number of times processLoop() returned from polling
+        UInt64 wakeups { 0 };
+
+        /// Wakeups without any ready event source (timeouts or interruptions)
+        UInt64 idleWakeups { 0 };
+
+        /// Wakeups requested by rendering threads or timers to unlock the loop
+        UInt64 unlockEvents { 0 };
+
+        /// Libseat event dispatches
+        UInt64 libseatDispatches { 0 };
+
+        /// Backends and user event loop dispatches (input events, timers, fd listeners)
+        UInt64 auxDispatches { 0 };
+
+        /// Wayland client requests dispatches
+        UInt64 waylandDispatches { 0 };
+
+        /// Client flushes performed at the end of processLoop()
+        UInt64 flushes { 0 };
+
+        /// Client flushes requested while dispatching (e.g. after releasing buffers) and deferred to the next flush
+        UInt64 deferredFlushes { 0 };
+    };
+
+    /**
+     * @brief Gets the main event loop counters.
+     *
+     * @see resetLoopCounters()
+     */
+    const LoopCounters &loopCounters() const noexcept;
+
+    /**
+     * @brief Resets all main event loop counters to 0.
+     */
+    void resetLoopCounters() noexcept;
+
+    /**
+     * @brief Sets the rate at which hidden surfaces receive frame callbacks.
+     *
+     * Surfaces release their frame callbacks when displayed (see LSurface::requestNextFrame()), so surfaces that are
+     * occluded, minimized or outside all outputs stop receiving them, which freezes clients relying on them for timers.\n
+     * Surfaces whose committed frame callbacks haven't been released for longer than the period of this rate
+     * have them released without clearing their damage, and their pending `wp_presentation` feedback is discarded.
+     *
+     * @param hz Frame callbacks per second, or 0 to never release them (hidden surfaces stay frozen).
+     *
+     * Defaults to 1 Hz.
+     */
+    void setHiddenSurfacesFrameRate(UInt32 hz) noexcept;
+
+    /**
+     * @brief Rate at which hidden surfaces receive frame callbacks.
+     *
+     * @see setHiddenSurfacesFrameRate()
+     */
+    UInt32 hiddenSurfacesFrameRate() const noexcept;
+
+    /**
+     * @brief Waits for the GPU work of clients before applying their DMA buffer commits.
+     *
+     * When enabled, a commit attaching a DMA buffer whose rendering hasn't finished yet (its implicit fences are unsignaled)
+     * is kept aside and applied once the fences signal, meanwhile the previous buffer remains displayed.
+     * This prevents a single slow client from stalling the compositor GPU queue and making all outputs miss frames.\n
+     * A waiting commit is applied immediately if its client sends any other request, except to a different `wl_surface`,
+     * so clients observe their requests being processed in order.
+     *
+     * Disabling it applies all waiting commits. Enabled by default.
+     */
+    void enableDMABufCommitQueue(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if DMA buffer commits wait for the client GPU work.
+     *
+     * @see enableDMABufCommitQueue()
+     */
+    bool dmaBufCommitQueueEnabled() const noexcept;
+
     /**
      * @brief Gets a pollable file descriptor of the main event loop.
      */
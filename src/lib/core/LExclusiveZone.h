@@ -177,7 +177,8 @@ public:
     /**
      * @brief Sets the rect change listener.
      *
-     * This callback is triggered each time the exclusive zone rect() changes, for example, after modifying its parameters or when other zones change.
+     * This callback is triggered each time the exclusive zone rect() changes, for example, after modifying its parameters or when other zones change.\n
+     * The rect() is updated immediately, but the callback is invoked at most once per main loop iteration, after all changes are applied.
      *
      * @param callback The callback function to be called on rect changes.
      */
@@ -203,6 +204,7 @@ private:
     LEdge m_edge;
     Int32 m_size;
     LRect m_rect;
+    LRect m_notifiedRect;
     mutable std::list<LExclusiveZone*>::iterator m_outputLink;
     OnRectChangeCallback m_onRectChangeCallback { nullptr };
 };
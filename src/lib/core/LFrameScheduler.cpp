@@ -0,0 +1,65 @@
+#include <LFrameScheduler.h>
+
+using namespace Louvre;
+
+void LFrameScheduler::addRenderDuration(UInt32 us) noexcept
+{
+    m_durations[m_durationsIndex] = us;
+    m_durationsIndex = (m_durationsIndex + 1) % WindowSize;
+
+    if (m_durationsCount < WindowSize)
+        m_durationsCount++;
+}
+
+UInt32 LFrameScheduler::predictedRenderDuration() const noexcept
+{
+    UInt32 max { 0 };
+
+    for (UInt32 i = 0; i < m_durationsCount; i++)
+        if (m_durations[i] > max)
+            max = m_durations[i];
+
+    return max;
+}
+
+UInt64 LFrameScheduler::schedule(UInt64 now, UInt64 lastVblank, UInt32 period) noexcept
+{
+    if (period == 0 || lastVblank == 0 || lastVblank > now + period)
+    {
+        m_deadline = 0;
+        return now;
+    }
+
+    // First vblank after now
+    UInt64 nextVblank { lastVblank + period };
+
+    if (nextVblank <= now)
+        nextVblank += ((now - nextVblank) / period + 1) * period;
+
+    m_deadline = nextVblank;
+    m_period = period;
+
+    if (m_durationsCount == 0)
+        return now;
+
+    const UInt64 budget { UInt64(predictedRenderDuration()) + m_safetyMargin };
+
+    if (budget >= period || nextVblank <= now + budget)
+        return now;
+
+    return nextVblank - budget;
+}
+
+void LFrameScheduler::framePresented(UInt64 time) noexcept
+{
+    if (m_deadline == 0)
+        return;
+
+    m_frames++;
+
+    // Vblank timestamps slightly differ from the extrapolated deadline
+    if (time > m_deadline + m_period / 2)
+        m_missedDeadlines++;
+
+    m_deadline = 0;
+}
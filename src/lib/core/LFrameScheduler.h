@@ -0,0 +1,125 @@
+#ifndef LFRAMESCHEDULER_H
+#define LFRAMESCHEDULER_H
+
+#include <LNamespaces.h>
+#include <array>
+
+/**
+ * @brief Deadline based frame scheduler
+ *
+ * Predicts how long an output takes to render a frame from the durations of recent frames and computes the latest time rendering
+ * can start while still making it before the next vblank. Durations span from the start of rendering until the GPU finished executing
+ * the frame commands, so they also account for GPU bound frames. Delaying rendering this way lets client commits that arrive during the
+ * refresh interval make it into the next frame, reducing the output latency by up to one frame.
+ *
+ * The predicted duration is the longest one of the last @ref WindowSize frames, plus a safetyMargin().\n
+ * All times are expressed in microseconds and must share the same monotonic clock base.
+ *
+ * Each output has its own instance, see LOutput::enableRenderDelay() and LOutput::frameScheduler().
+ */
+class Louvre::LFrameScheduler
+{
+public:
+    /// Number of recent render durations used for the prediction
+    static constexpr UInt32 WindowSize { 32 };
+
+    /**
+     * @brief Constructs a scheduler without samples.
+     */
+    LFrameScheduler() noexcept = default;
+
+    /**
+     * @brief Sets the extra time in microseconds reserved before each vblank.
+     *
+     * Higher values reduce missed deadlines at the cost of latency. Defaults to 1500 µs.
+     */
+    void setSafetyMargin(UInt32 us) noexcept
+    {
+        m_safetyMargin = us;
+    }
+
+    /**
+     * @brief Extra time in microseconds reserved before each vblank.
+     */
+    UInt32 safetyMargin() const noexcept
+    {
+        return m_safetyMargin;
+    }
+
+    /**
+     * @brief Adds the duration of a rendered frame in microseconds.
+     */
+    void addRenderDuration(UInt32 us) noexcept;
+
+    /**
+     * @brief Predicted render duration in microseconds or 0 if there are no samples yet.
+     */
+    UInt32 predictedRenderDuration() const noexcept;
+
+    /**
+     * @brief Computes when the next frame should start rendering.
+     *
+     * The target vblank is the first one after `now`, extrapolated from `lastVblank` and `period`. If the timing information is
+     * unknown, there are no samples yet, or the predicted duration does not fit into a refresh period, `now` is returned.
+     *
+     * @param now Current time.
+     * @param lastVblank Time of the last presented frame or 0 if unknown.
+     * @param period Refresh period or 0 if unknown.
+     * @return The time rendering should start, never earlier than `now`.
+     */
+    UInt64 schedule(UInt64 now, UInt64 lastVblank, UInt32 period) noexcept;
+
+    /**
+     * @brief The vblank targeted by the last schedule() call or 0 if there was none.
+     */
+    UInt64 deadline() const noexcept
+    {
+        return m_deadline;
+    }
+
+    /**
+     * @brief Notifies that the scheduled frame was presented.
+     *
+     * Counts a missed deadline if `time` is more than half a refresh period later than deadline(), which means the frame
+     * was displayed at a later vblank.
+     *
+     * @param time Presentation time reported by the graphic backend.
+     */
+    void framePresented(UInt64 time) noexcept;
+
+    /**
+     * @brief Number of frames presented with a deadline.
+     */
+    UInt64 frames() const noexcept
+    {
+        return m_frames;
+    }
+
+    /**
+     * @brief Number of frames presented after their deadline.
+     */
+    UInt64 missedDeadlines() const noexcept
+    {
+        return m_missedDeadlines;
+    }
+
+    /**
+     * @brief Clears the frames() and missedDeadlines() counters.
+     */
+    void resetStats() noexcept
+    {
+        m_frames = m_missedDeadlines = 0;
+    }
+
+private:
+    std::array<UInt32, WindowSize> m_durations {};
+    UInt32 m_durationsCount { 0 };
+    UInt32 m_durationsIndex { 0 };
+    UInt32 m_safetyMargin { 1500 };
+    UInt64 m_deadline { 0 };
+    UInt32 m_period { 0 };
+    UInt64 m_frames { 0 };
+    UInt64 m_missedDeadlines { 0 };
+};
+
+#endif // LFRAMESCHEDULER_H
@@ -0,0 +1,68 @@
+#include <LLatencyHistogram.h>
+#include <LLog.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Louvre;
+
+void LLatencyHistogram::add(UInt32 us) noexcept
+{
+    m_buckets[bucketIndex(us)]++;
+    m_count++;
+    m_sum += us;
+
+    if (us < m_min)
+        m_min = us;
+
+    if (us > m_max)
+        m_max = us;
+}
+
+void LLatencyHistogram::reset() noexcept
+{
+    m_buckets.fill(0);
+    m_count = m_sum = 0;
+    m_min = UINT32_MAX;
+    m_max = 0;
+}
+
+UInt32 LLatencyHistogram::percentile(Float32 percent) const noexcept
+{
+    if (m_count == 0)
+        return 0;
+
+    if (percent <= 0.f)
+        return min();
+
+    const UInt64 target { std::min(m_count, UInt64(std::ceil(Float64(m_count) * Float64(percent) / 100.0))) };
+    UInt64 accum { 0 };
+
+    for (UInt32 i = 0; i < BucketCount; i++)
+    {
+        accum += m_buckets[i];
+
+        if (accum >= target)
+            return std::min(bucketUpperBound(i), m_max);
+    }
+
+    return m_max;
+}
+
+UInt32 LLatencyHistogram::bucketIndex(UInt32 us) noexcept
+{
+    if (us < 2)
+        return 0;
+
+    const UInt32 index { UInt32(31 - __builtin_clz(us)) };
+    return index >= BucketCount ? BucketCount - 1 : index;
+}
+
+void LLatencyHistogram::log(const char *name) const noexcept
+{
+    LLog::log("[%s] samples: %llu, min: %u us, mean: %.1f us, p50: %u us, p99: %u us, max: %u us.",
+              name, (unsigned long long)m_count, min(), mean(), percentile(50.f), percentile(99.f), m_max);
+
+    for (UInt32 i = 0; i < BucketCount; i++)
+        if (m_buckets[i] > 0)
+            LLog::log("[%s]     < %u us: %llu", name, bucketUpperBound(i), (unsigned long long)m_buckets[i]);
+}
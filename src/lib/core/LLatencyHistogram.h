@@ -0,0 +1,117 @@
+#ifndef LLATENCYHISTOGRAM_H
+#define LLATENCYHISTOGRAM_H
+
+#include <LNamespaces.h>
+#include <array>
+
+/**
+ * @brief Latency histogram
+ *
+ * Accumulates latency samples in microseconds into power of two buckets, keeping the count, minimum, maximum and mean
+ * without storing each sample.\n
+ * Bucket `0` holds samples in the `[0, 2)` µs range and each bucket `i > 0` holds samples in the `[2^i, 2^(i+1))` µs range,
+ * except for the last one, which also holds every larger sample.
+ *
+ * @see LSeat::pointerLatency()
+ */
+class Louvre::LLatencyHistogram
+{
+public:
+    /// Number of buckets
+    static constexpr UInt32 BucketCount { 24 };
+
+    /**
+     * @brief Constructs an empty histogram.
+     */
+    LLatencyHistogram() noexcept = default;
+
+    /**
+     * @brief Adds a sample.
+     *
+     * @param us Latency in microseconds.
+     */
+    void add(UInt32 us) noexcept;
+
+    /**
+     * @brief Removes all samples.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Number of samples.
+     */
+    UInt64 count() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Smallest sample in microseconds or 0 if empty.
+     */
+    UInt32 min() const noexcept
+    {
+        return m_count == 0 ? 0 : m_min;
+    }
+
+    /**
+     * @brief Largest sample in microseconds.
+     */
+    UInt32 max() const noexcept
+    {
+        return m_max;
+    }
+
+    /**
+     * @brief Mean of all samples in microseconds or 0 if empty.
+     */
+    Float64 mean() const noexcept
+    {
+        return m_count == 0 ? 0.0 : Float64(m_sum) / Float64(m_count);
+    }
+
+    /**
+     * @brief Approximate percentile.
+     *
+     * Returns the upper bound of the bucket containing the given percentile, clamped to max().
+     *
+     * @param percent Value in the `[0, 100]` range, e.g. `99.f` for the 99th percentile.
+     */
+    UInt32 percentile(Float32 percent) const noexcept;
+
+    /**
+     * @brief Number of samples stored in each bucket.
+     */
+    const std::array<UInt64, BucketCount> &buckets() const noexcept
+    {
+        return m_buckets;
+    }
+
+    /**
+     * @brief Index of the bucket a sample falls into.
+     */
+    static UInt32 bucketIndex(UInt32 us) noexcept;
+
+    /**
+     * @brief Exclusive upper bound of a bucket in microseconds.
+     */
+    static UInt32 bucketUpperBound(UInt32 index) noexcept
+    {
+        return index >= BucketCount - 1 ? UINT32_MAX : (UInt32(1) << (index + 1));
+    }
+
+    /**
+     * @brief Prints a summary and the non empty buckets using LLog::log().
+     *
+     * @param name Label printed before the summary.
+     */
+    void log(const char *name) const noexcept;
+
+private:
+    std::array<UInt64, BucketCount> m_buckets {};
+    UInt64 m_count { 0 };
+    UInt64 m_sum { 0 };
+    UInt32 m_min { UINT32_MAX };
+    UInt32 m_max { 0 };
+};
+
+#endif // LLATENCYHISTOGRAM_H
@@ -100,7 +100,9 @@ namespace Louvre
     class LResource;
     class LSessionLockManager;
     class LSurface;
+    class LSurfaceCapture;
     class LTexture;
+    class LTextureAtlas;
     class LScreenshotRequest;
     class LActivationTokenManager;
     class LActivationToken;
@@ -118,6 +120,7 @@ namespace Louvre
     class LTextureView;
     class LSolidColorView;
     class LSceneView;
+    class LBlurView;
     class LSceneTouchPoint;
 
     // Data
@@ -193,6 +196,8 @@ namespace Louvre
     class LLog;
     class LTime;
     class LTimer;
+    class LLatencyHistogram;
+    class LFrameScheduler;
     class LLauncher;
     class LGammaTable;
     class LWeakUtils;
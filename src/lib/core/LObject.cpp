@@ -3,6 +3,20 @@
 
 using namespace Louvre;
 
+void LObject::WeakRefs::grow() noexcept
+{
+    void **heap { new void*[m_capacity * 2] };
+
+    for (UInt32 i = 0; i < m_size; i++)
+        heap[i] = data()[i];
+
+    if (m_capacity > InlineCapacity)
+        delete[] m_heap;
+
+    m_heap = heap;
+    m_capacity *= 2;
+}
+
 LObject::~LObject() noexcept
 {
     notifyDestruction();
@@ -18,10 +18,7 @@ public:
      *
      * @note The user data and LWeak references are not copied.
      */
-    LObject(const LObject &) noexcept
-    {
-        m_weakRefs.reserve(10);
-    }
+    LObject(const LObject &) noexcept {}
 
     /**
      * @brief Assignment operator (each object has its own individual LWeak reference count).
@@ -73,7 +70,76 @@ protected:
 
 private:
     friend class LWeakUtils;
-    mutable std::vector<void*> m_weakRefs;
+
+    /* LWeak references pointing to the object, each LWeak stores its index so they are removed in O(1).
+     * Most objects have none or very few, so the first ones are stored inline without allocating */
+    class WeakRefs
+    {
+    public:
+        WeakRefs() noexcept = default;
+        WeakRefs(const WeakRefs &) = delete;
+        WeakRefs &operator=(const WeakRefs &) = delete;
+
+        ~WeakRefs() noexcept
+        {
+            if (m_capacity > InlineCapacity)
+                delete[] m_heap;
+        }
+
+        UInt32 size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        void *&operator[](UInt32 index) noexcept
+        {
+            return data()[index];
+        }
+
+        void *back() noexcept
+        {
+            return data()[m_size - 1];
+        }
+
+        void push_back(void *ref) noexcept
+        {
+            if (m_size == m_capacity)
+                grow();
+
+            data()[m_size++] = ref;
+        }
+
+        void pop_back() noexcept
+        {
+            m_size--;
+        }
+
+    private:
+        static constexpr UInt32 InlineCapacity { 2 };
+
+        void **data() noexcept
+        {
+            return m_capacity > InlineCapacity ? m_heap : m_inline;
+        }
+
+        void grow() noexcept;
+
+        union
+        {
+            void *m_inline[InlineCapacity];
+            void **m_heap;
+        };
+
+        UInt32 m_size { 0 };
+        UInt32 m_capacity { InlineCapacity };
+    };
+
+    mutable WeakRefs m_weakRefs;
     mutable UIntPtr m_userData { 0 };
     bool m_destroyed { false };
 };
@@ -1,5 +1,7 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <other/stb_image.h>
+#include <private/LAsyncTextureLoader.h>
+#include <private/LCompositorPrivate.h>
 #include <LOpenGL.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -130,24 +132,42 @@ LTexture *LOpenGL::loadTexture(const std::filesystem::path &file)
         return nullptr;
     }
 
-    LTexture *texture { new LTexture() };
+    LTexture *texture { LAsyncTextureLoader::createTexture(LSize(width, height), image) };
+    free(image);
+    return texture;
+}
 
-    if (!texture->setDataFromMainMemory(LSize(width, height), width * 4, DRM_FORMAT_ABGR8888, image))
-    {
-        UInt8 pix { 0 };
+static LAsyncTextureLoader &asyncTextureLoader()
+{
+    auto &loader { compositor()->imp()->asyncTextureLoader };
 
-        for (int i = 0; i < width * 4 * height; i+=4)
-        {
-            pix = image[i + 2];
-            image[i + 2] = image[i];
-            image[i] = pix;
-        }
+    if (!loader)
+        loader = std::make_unique<LAsyncTextureLoader>();
 
-        texture->setDataFromMainMemory(LSize(width, height), width * 4, DRM_FORMAT_ARGB8888, image);
+    return *loader;
+}
+
+UInt32 LOpenGL::loadTextureAsync(const std::filesystem::path &file, const std::function<void(LTexture*)> &callback)
+{
+    if (!compositor()->imp()->auxEventLoop || !compositor()->imp()->isGraphicBackendInitialized)
+    {
+        LLog::error("[LOpenGL::loadTextureAsync] The compositor is not initialized, loading the texture synchronously.");
+        callback(loadTexture(file));
+        return 0;
     }
 
-    free(image);
-    return texture;
+    return asyncTextureLoader().load(file, callback);
+}
+
+void LOpenGL::cancelLoadTextureAsync(UInt32 id)
+{
+    if (compositor()->imp()->asyncTextureLoader)
+        compositor()->imp()->asyncTextureLoader->cancel(id);
+}
+
+void LOpenGL::setAsyncTextureUploadBudget(UInt32 bytes)
+{
+    compositor()->imp()->asyncTextureUploadBudget = bytes;
 }
 
 bool LOpenGL::hasExtension(const char *extensions, const char *extension)
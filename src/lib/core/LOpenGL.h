@@ -3,6 +3,7 @@
 
 #include <LNamespaces.h>
 #include <filesystem>
+#include <functional>
 
 /**
  * @brief OpenGL utility functions.
@@ -63,6 +64,38 @@ public:
      */
     static LTexture *loadTexture(const std::filesystem::path &file);
 
+    /**
+     * @brief Create a texture from an image file asynchronously.
+     *
+     * Same as loadTexture() but the image is decoded on a pool of worker threads, so large files do not
+     * block the compositor. The texture is then created on the main thread and passed to the callback,
+     * or `nullptr` in case of error. Uploads are spread across main loop iterations, see setAsyncTextureUploadBudget().
+     *
+     * @note Must be called from the main thread, once the compositor is initialized. The callback is also
+     *       invoked from the main thread and takes ownership of the texture.
+     *
+     * @param file Path to the image file. Same formats as loadTexture().
+     * @param callback Function called once the texture is ready.
+     * @returns An identifier that can be passed to cancelLoadTextureAsync(), or 0 if the callback was already called.
+     */
+    static UInt32 loadTextureAsync(const std::filesystem::path &file, const std::function<void(LTexture*)> &callback);
+
+    /**
+     * @brief Cancels a loadTextureAsync() request.
+     *
+     * The callback of the request won't be called. Does nothing if it was already called.
+     */
+    static void cancelLoadTextureAsync(UInt32 id);
+
+    /**
+     * @brief Sets the maximum number of bytes uploaded by loadTextureAsync() per main loop iteration.
+     *
+     * At least one texture is always uploaded per iteration, even if it exceeds the budget.
+     *
+     * Defaults to 16 MB.
+     */
+    static void setAsyncTextureUploadBudget(UInt32 bytes);
+
     /**
      * @brief Check if a specific OpenGL extension is available.
      *
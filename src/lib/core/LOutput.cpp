@@ -110,6 +110,26 @@ bool LOutput::enableVSync(bool enabled) noexcept
     return compositor()->imp()->graphicBackend->outputEnableVSync((LOutput*)this, enabled);
 }
 
+void LOutput::enableRenderDelay(bool enabled) noexcept
+{
+    imp()->stateFlags.setFlag(LOutputPrivate::RenderDelay, enabled);
+}
+
+bool LOutput::renderDelayEnabled() const noexcept
+{
+    return imp()->stateFlags.check(LOutputPrivate::RenderDelay);
+}
+
+LFrameScheduler &LOutput::frameScheduler() const noexcept
+{
+    return imp()->frameScheduler;
+}
+
+UInt64 LOutput::regionAllocations() const noexcept
+{
+    return imp()->regionAllocations;
+}
+
 Int32 LOutput::refreshRateLimit() const noexcept
 {
     return compositor()->imp()->graphicBackend->outputGetRefreshRateLimit((LOutput*)this);
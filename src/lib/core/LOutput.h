@@ -153,7 +153,9 @@
  * Rendering using fractional scaling, however, can introduce undesired visual effects like aliasing, especially noticeable when moving elements with textures containing fine details.
  * For this reason, Louvre offers the option to render using oversampling, where all the screen content is rendered into a larger buffer, and then that rendered buffer is scaled down to the actual screen framebuffer.
  * This method almost completely eliminates aliasing but has the disadvantage of consuming more computational power, potentially decreasing performance.
- * Without oversampling the content is directly rendered on the screen, making it efficient but retaining aliasing artifacts.\n
+ * Without oversampling the content is directly rendered on the screen, making it efficient but retaining aliasing artifacts.
+ * In this mode no intermediate framebuffer is used, and LPainter snaps texture edges to framebuffer pixels, so buffers of clients
+ * using the fractional scaling protocol are mapped 1:1 to the screen pixels.\n
  * Louvre allows you to toggle oversampling on and off instantly at any time using enableFractionalOversampling().
  * For example, you could enable it when displaying a desktop with floating windows and disable it when displaying a fullscreen window.
  *
@@ -479,6 +481,50 @@ public:
      */
     bool enableVSync(bool enabled) noexcept;
 
+    /**
+     * @brief Enables or disables render delay (late frame scheduling).
+     *
+     * By default, paintGL() is called as soon as the graphic backend requests a new frame, right after the previous page flip,
+     * so client commits arriving later during the refresh interval have to wait an entire frame.\n
+     * When enabled, the start of each frame is delayed to the latest time it can still be presented at the next vblank,
+     * based on the durations of recent frames. See LFrameScheduler for details.
+     *
+     * Durations are measured until the GPU finishes each frame (using `EGL_KHR_fence_sync` if available, or `glFinish()` otherwise),
+     * so the output thread waits for the GPU after paintGL() while it is enabled. Missed deadlines are counted from the actual
+     * presentation time of each frame.
+     *
+     * @note Only takes effect while VSync is enabled.
+     *
+     * Disabled by default.
+     */
+    void enableRenderDelay(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if render delay is enabled.
+     *
+     * @see enableRenderDelay()
+     */
+    bool renderDelayEnabled() const noexcept;
+
+    /**
+     * @brief Frame scheduler used when render delay is enabled.
+     *
+     * Can be used to adjust the safety margin or to query missed deadline statistics.
+     *
+     * @warning It is updated from the output rendering thread, its statistics should only be queried within paintGL() or while the output is not rendering.
+     */
+    LFrameScheduler &frameScheduler() const noexcept;
+
+    /**
+     * @brief Number of LRegion box storage allocations made while rendering the last frame.
+     *
+     * Includes the paintGL() event and the damage conversion to buffer coordinates, see LRegion::allocationsCount().\n
+     * A scene that doesn't change between frames should ideally keep it at 0.
+     *
+     * @warning It is updated from the output rendering thread, it should only be queried within paintGL() or while the output is not rendering.
+     */
+    UInt64 regionAllocations() const noexcept;
+
     /**
      * @brief Gets the refresh rate limit in Hz when VSync is disabled.
      *
@@ -627,6 +673,9 @@ public:
     /**
      * @brief Toggles oversampling for fractional scales.
      *
+     * When disabled, the scene is rendered directly into the output framebuffer at the fractional scale, which roughly
+     * halves the fill rate and memory bandwidth required, at the cost of some aliasing. See the @ref Scaling "Scaling Section".
+     *
      * @note Oversampling is always turned off for integer scales.
      *       You can instantly turn oversampling on or off when using a fractional scale.
      *
@@ -876,7 +925,9 @@ public:
     /**
      * @brief Notifies a change in availableGeometry().
      *
-     * This event is triggered whenever one of the exclusiveZones() changes.
+     * This event is triggered whenever one of the exclusiveZones() changes.\n
+     * Changes made within the same main loop iteration, for example while outputs are plugged, moved or rescaled,
+     * are notified once.
      *
      * #### Default Implementation
      *
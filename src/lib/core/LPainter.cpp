@@ -9,7 +9,9 @@
 #include <LLog.h>
 
 #include <GLES2/gl2.h>
+#include <algorithm>
 #include <cstdio>
+#include <cmath>
 #include <string.h>
 
 using namespace Louvre;
@@ -29,6 +31,123 @@ static void makeExternalShader(std::string &shader) noexcept
     }
 }
 
+/* Specialized render program sources, each variant is built by prepending
+ * the #defines matching its ProgramFlags key */
+
+static const GLchar *variantVertexShaderStr = R"(
+    precision mediump float;
+    uniform mediump vec4 srcRect;
+    attribute mediump vec4 vertexPosition;
+    varying mediump vec2 v_texcoord;
+
+    void main()
+    {
+        gl_Position = vec4(vertexPosition.xy, 0.0, 1.0);
+
+    #ifndef COLOR_MODE
+        if (vertexPosition.x == -1.0)
+            v_texcoord.x = srcRect.x;
+        else
+            v_texcoord.x = srcRect.z;
+
+        if (vertexPosition.y == 1.0)
+            v_texcoord.y = srcRect.y;
+        else
+            v_texcoord.y = srcRect.w;
+
+        #ifdef HAS_90DEG
+        v_texcoord.yx = v_texcoord;
+        #endif
+    #endif
+    }
+    )";
+
+static const GLchar *variantFragmentShaderStr = R"(
+    uniform mediump SAMPLER tex;
+    uniform mediump float alpha;
+    uniform mediump vec3 color;
+    varying mediump vec2 v_texcoord;
+
+    #ifdef BLUR
+    uniform mediump vec2 blurStep;
+    uniform mediump float blurWeights[BLUR_MAX_TAPS];
+    uniform mediump float blurOffsets[BLUR_MAX_TAPS];
+    uniform int blurTaps;
+
+    // Symmetric kernel, each tap except the center one is sampled on both sides
+    mediump vec4 sampleTex()
+    {
+        mediump vec4 sum = texture2D(tex, v_texcoord) * blurWeights[0];
+
+        for (int i = 1; i < BLUR_MAX_TAPS; i++)
+        {
+            if (i >= blurTaps)
+                break;
+
+            mediump vec2 offset = blurStep * blurOffsets[i];
+            sum += (texture2D(tex, v_texcoord + offset) + texture2D(tex, v_texcoord - offset)) * blurWeights[i];
+        }
+
+        return sum;
+    }
+    #else
+    #define sampleTex() texture2D(tex, v_texcoord)
+    #endif
+
+    void main()
+    {
+    #if defined(COLOR_MODE)
+        gl_FragColor = vec4(color, alpha);
+    #elif defined(TEX_COLOR)
+        gl_FragColor.xyz = color;
+        gl_FragColor.w = texture2D(tex, v_texcoord).w;
+        #ifdef ALPHA
+        gl_FragColor.w *= alpha;
+        #endif
+    #else
+        gl_FragColor = sampleTex();
+        #ifdef ALPHA
+            #ifdef PREMULTIPLIED_ALPHA
+        gl_FragColor *= alpha;
+            #else
+        gl_FragColor.w *= alpha;
+            #endif
+        #endif
+        #ifdef COLOR_FACTOR
+        gl_FragColor.xyz *= color;
+        #endif
+    #endif
+    }
+    )";
+
+static std::string variantDefines(UInt8 key, bool fragment) noexcept
+{
+    using P = LPainter::LPainterPrivate;
+    std::string defines;
+
+    if (key & P::ExternalOESProgram && fragment)
+        defines += "#extension GL_OES_EGL_image_external : require\n#define SAMPLER samplerExternalOES\n";
+    else
+        defines += "#define SAMPLER sampler2D\n";
+
+    if (key & P::ColorModeProgram)
+        defines += "#define COLOR_MODE\n";
+    if (key & P::TexColorProgram)
+        defines += "#define TEX_COLOR\n";
+    if (key & P::PremultipliedAlphaProgram)
+        defines += "#define PREMULTIPLIED_ALPHA\n";
+    if (key & P::ColorFactorProgram)
+        defines += "#define COLOR_FACTOR\n";
+    if (key & P::AlphaProgram)
+        defines += "#define ALPHA\n";
+    if (key & P::Has90DegProgram)
+        defines += "#define HAS_90DEG\n";
+    if (key & P::BlurProgram)
+        defines += "#define BLUR\n#define BLUR_MAX_TAPS " + std::to_string(P::MaxBlurTaps) + "\n";
+
+    return defines;
+}
+
 LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
 {
     imp()->painter = this;
@@ -38,7 +157,7 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
     imp()->updateExtensions();
     imp()->updateCPUFormats();
 
-    // Open the vertex/fragment shaders
+    // Vertex shader used by the scaler programs (legacy mode)
     GLchar vShaderStr[] = R"(
         precision mediump float;
         precision mediump int;
@@ -47,30 +166,12 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
         attribute mediump vec4 vertexPosition;
         varying mediump vec2 v_texcoord;
         uniform lowp int mode;
-        uniform bool has90deg;
 
         void main()
         {
             gl_Position = vec4(vertexPosition.xy, 0.0, 1.0);
 
-            if (mode == 1)
-            {
-                if (vertexPosition.x == -1.0)
-                    v_texcoord.x = srcRect.x;
-                else
-                    v_texcoord.x = srcRect.z;
-
-                if (vertexPosition.y == 1.0)
-                    v_texcoord.y = srcRect.y;
-                else
-                    v_texcoord.y = srcRect.w;
-
-                if (has90deg)
-                    v_texcoord.yx = v_texcoord;
-
-                return;
-            }
-            else if (mode == 0)
+            if (mode == 0)
             {
                 v_texcoord.x = (srcRect.x + vertexPosition.z*srcRect.z) / texSize.x;
                 v_texcoord.y = (srcRect.y + srcRect.w - vertexPosition.w*srcRect.w) / texSize.y;
@@ -78,65 +179,6 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
         }
         )";
 
-    GLchar fShaderStr[] =R"(
-        uniform mediump sampler2D tex;
-        uniform bool colorFactorEnabled;
-        uniform lowp int mode;
-        uniform mediump float alpha;
-        uniform mediump vec3 color;
-        varying mediump vec2 v_texcoord;
-        uniform bool texColorEnabled;
-        uniform bool premultipliedAlpha;
-
-        void main()
-        {
-            // Texture
-            if (mode != 2)
-            {
-                if (texColorEnabled)
-                {
-                    gl_FragColor.xyz = color;
-                    gl_FragColor.w = texture2D(tex, v_texcoord).w;
-                    if (alpha != 1.0)
-                        gl_FragColor.w *= alpha;
-                }
-                else
-                {
-                    if (premultipliedAlpha)
-                    {
-                        gl_FragColor = texture2D(tex, v_texcoord);
-
-                        if (alpha != 1.0)
-                            gl_FragColor *= alpha;
-
-                        if (colorFactorEnabled)
-                            gl_FragColor.xyz *= color;
-                    }
-                    else
-                    {
-                        gl_FragColor = texture2D(tex, v_texcoord);
-
-                        if (alpha != 1.0)
-                            gl_FragColor.w *= alpha;
-
-                        if (colorFactorEnabled)
-                            gl_FragColor.xyz *= color;
-                    }
-                }
-            }
-
-            // Solid color
-            else
-            {
-                gl_FragColor.xyz = color;
-                gl_FragColor.w = alpha;
-            }
-        }
-        )";
-
-    std::string fShaderStrExternal = fShaderStr;
-    makeExternalShader(fShaderStrExternal);
-
     GLchar fShaderStrScaler[] =R"(
         precision highp float;
         precision highp int;
@@ -178,12 +220,10 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
         }
         )";
 
-    std::string fShaderStrScalerExternal = fShaderStr;
+    std::string fShaderStrScalerExternal = fShaderStrScaler;
     makeExternalShader(fShaderStrScalerExternal);
 
-    imp()->vertexShader = LOpenGL::compileShader(GL_VERTEX_SHADER, vShaderStr);
-    imp()->fragmentShader = LOpenGL::compileShader(GL_FRAGMENT_SHADER, fShaderStr);
-    imp()->fragmentShaderExternal = LOpenGL::compileShader(GL_FRAGMENT_SHADER, fShaderStrExternal.c_str());
+    imp()->vertexShaderScaler = LOpenGL::compileShader(GL_VERTEX_SHADER, vShaderStr);
     imp()->fragmentShaderScaler = LOpenGL::compileShader(GL_FRAGMENT_SHADER, fShaderStrScaler);
     imp()->fragmentShaderScalerExternal = LOpenGL::compileShader(GL_FRAGMENT_SHADER, fShaderStrScalerExternal.c_str());
 
@@ -192,8 +232,9 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
     /************** SCALER PROGRAM **************/
 
     imp()->programObjectScaler = glCreateProgram();
-    glAttachShader(imp()->programObjectScaler, imp()->vertexShader);
+    glAttachShader(imp()->programObjectScaler, imp()->vertexShaderScaler);
     glAttachShader(imp()->programObjectScaler, imp()->fragmentShaderScaler);
+    glBindAttribLocation(imp()->programObjectScaler, 0, "vertexPosition");
 
     // Link the program
     glLinkProgram(imp()->programObjectScaler);
@@ -203,8 +244,6 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
 
     if (!linked)
     {
-        GLint infoLen = 0;
-        glGetProgramiv(imp()->programObjectScaler, GL_INFO_LOG_LENGTH, &infoLen);
         glDeleteProgram(imp()->programObjectScaler);
         imp()->programObjectScaler = 0;
         LLog::error("[LPainter::LPainter] Failed to compile scaler shader.");
@@ -219,8 +258,9 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
     /************** SCALER PROGRAM EXTERNAL **************/
 
     imp()->programObjectScalerExternal = glCreateProgram();
-    glAttachShader(imp()->programObjectScalerExternal, imp()->vertexShader);
+    glAttachShader(imp()->programObjectScalerExternal, imp()->vertexShaderScaler);
     glAttachShader(imp()->programObjectScalerExternal, imp()->fragmentShaderScalerExternal);
+    glBindAttribLocation(imp()->programObjectScalerExternal, 0, "vertexPosition");
 
     // Link the program
     glLinkProgram(imp()->programObjectScalerExternal);
@@ -230,8 +270,6 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
 
     if (!linked)
     {
-        GLint infoLen = 0;
-        glGetProgramiv(imp()->programObjectScalerExternal, GL_INFO_LOG_LENGTH, &infoLen);
         glDeleteProgram(imp()->programObjectScalerExternal);
         imp()->programObjectScalerExternal = 0;
         LLog::error("[LPainter::LPainter] Failed to compile scaler shader external.");
@@ -243,61 +281,21 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
         imp()->setupProgramScaler();
     }
 
-    /************** RENDER PROGRAM EXTERNAL **************/
-
-    imp()->programObjectExternal = glCreateProgram();
-    glAttachShader(imp()->programObjectExternal, imp()->vertexShader);
-    glAttachShader(imp()->programObjectExternal, imp()->fragmentShaderExternal);
-
-    // Link the program
-    glLinkProgram(imp()->programObjectExternal);
-
-    // Check the link status
-    glGetProgramiv(imp()->programObjectExternal, GL_LINK_STATUS, &linked);
-
-    if (!linked)
-    {
-        GLint infoLen = 0;
-        glGetProgramiv(imp()->programObjectExternal, GL_INFO_LOG_LENGTH, &infoLen);
-        glDeleteProgram(imp()->programObjectExternal);
-        LLog::error("[LPainter::LPainter] Failed to compile external OES shader.");
-    }
-    else
-    {
-        imp()->currentProgram = imp()->programObjectExternal;
-#if LPAINTER_TRACK_UNIFORMS == 1
-        imp()->currentState = &imp()->stateExternal;
-#endif
-        imp()->currentUniforms = &imp()->uniformsExternal;
-        imp()->setupProgram();
-    }
-
-    /************** RENDER PROGRAM **************/
-
-    imp()->programObject = glCreateProgram();
-    glAttachShader(imp()->programObject, imp()->vertexShader);
-    glAttachShader(imp()->programObject, imp()->fragmentShader);
+    /************** RENDER PROGRAMS **************/
 
-    // Link the program
-    glLinkProgram(imp()->programObject);
+    // The remaining variants are compiled on demand by bindProgramVariant()
+    if (!imp()->createProgramVariant(0))
+        exit(-1);
 
-    // Check the link status
-    glGetProgramiv(imp()->programObject, GL_LINK_STATUS, &linked);
+    imp()->createProgramVariant(LPainterPrivate::ColorModeProgram);
+    imp()->currentVariant = nullptr;
+    imp()->bindProgramVariant();
 
-    if (!linked)
-    {
-        GLint infoLen = 0;
-        glGetProgramiv(imp()->programObject, GL_INFO_LOG_LENGTH, &infoLen);
-        glDeleteProgram(imp()->programObject);
-        exit(-1);
-    }
+    // Load the vertex data
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, imp()->square);
 
-    imp()->currentProgram = imp()->programObject;
-#if LPAINTER_TRACK_UNIFORMS == 1
-    imp()->currentState = &imp()->state;
-#endif
-    imp()->currentUniforms = &imp()->uniforms;
-    imp()->setupProgram();
+    // Enables the vertex array
+    glEnableVertexAttribArray(0);
 
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 1.0f);
@@ -311,57 +309,198 @@ LPainter::LPainter() noexcept : LPRIVATE_INIT_UNIQUE(LPainter)
     glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
     glDisable(GL_SAMPLE_COVERAGE);
     glDisable(GL_SAMPLE_ALPHA_TO_ONE);
-
-    imp()->shaderSetAlpha(1.f);
 }
 
 LPainter::~LPainter() noexcept
 {
-    glDeleteProgram(imp()->programObject);
-    glDeleteProgram(imp()->programObjectExternal);
-    glDeleteShader(imp()->fragmentShaderExternal);
-    glDeleteShader(imp()->fragmentShader);
-    glDeleteShader(imp()->vertexShader);
+    for (const auto &variant : imp()->programs)
+        if (variant.id)
+            glDeleteProgram(variant.id);
+
+    if (imp()->programObjectScaler)
+        glDeleteProgram(imp()->programObjectScaler);
+
+    if (imp()->programObjectScalerExternal)
+        glDeleteProgram(imp()->programObjectScalerExternal);
+
+    glDeleteShader(imp()->fragmentShaderScalerExternal);
+    glDeleteShader(imp()->fragmentShaderScaler);
+    glDeleteShader(imp()->vertexShaderScaler);
 }
 
-void LPainter::LPainterPrivate::setupProgram() noexcept
+bool LPainter::LPainterPrivate::createProgramVariant(UInt8 key) noexcept
 {
-    glBindAttribLocation(currentProgram, 0, "vertexPosition");
+    ProgramVariant &variant { programs[key] };
 
-    // Use the program object
-    glUseProgram(currentProgram);
+    if (variant.id)
+        return true;
 
-    // Load the vertex data
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, square);
+    if (variant.failed)
+        return false;
 
-    // Enables the vertex array
-    glEnableVertexAttribArray(0);
+    const std::string vSrc { variantDefines(key, false) + variantVertexShaderStr };
+    const std::string fSrc { variantDefines(key, true) + variantFragmentShaderStr };
 
-    // Get Uniform Variables
-    currentUniforms->texSize = glGetUniformLocation(currentProgram, "texSize");
-    currentUniforms->srcRect = glGetUniformLocation(currentProgram, "srcRect");
-    currentUniforms->activeTexture = glGetUniformLocation(currentProgram, "tex");
-    currentUniforms->mode = glGetUniformLocation(currentProgram, "mode");
-    currentUniforms->color= glGetUniformLocation(currentProgram, "color");
-    currentUniforms->texColorEnabled = glGetUniformLocation(currentProgram, "texColorEnabled");
-    currentUniforms->colorFactorEnabled = glGetUniformLocation(currentProgram, "colorFactorEnabled");
-    currentUniforms->alpha = glGetUniformLocation(currentProgram, "alpha");
-    currentUniforms->premultipliedAlpha = glGetUniformLocation(currentProgram, "premultipliedAlpha");
-    currentUniforms->has90deg = glGetUniformLocation(currentProgram, "has90deg");
+    const GLuint vShader { LOpenGL::compileShader(GL_VERTEX_SHADER, vSrc.c_str()) };
+    const GLuint fShader { LOpenGL::compileShader(GL_FRAGMENT_SHADER, fSrc.c_str()) };
+
+    if (!vShader || !fShader)
+    {
+        if (vShader) glDeleteShader(vShader);
+        if (fShader) glDeleteShader(fShader);
+        variant.failed = true;
+        LLog::error("[LPainter::createProgramVariant] Failed to compile shader variant %d.", key);
+        return false;
+    }
+
+    variant.id = glCreateProgram();
+    glAttachShader(variant.id, vShader);
+    glAttachShader(variant.id, fShader);
+    glBindAttribLocation(variant.id, 0, "vertexPosition");
+    glLinkProgram(variant.id);
+
+    // Released along with the program
+    glDeleteShader(vShader);
+    glDeleteShader(fShader);
+
+    GLint linked;
+    glGetProgramiv(variant.id, GL_LINK_STATUS, &linked);
+
+    if (!linked)
+    {
+        glDeleteProgram(variant.id);
+        variant.id = 0;
+        variant.failed = true;
+        LLog::error("[LPainter::createProgramVariant] Failed to link shader variant %d.", key);
+        return false;
+    }
+
+    variant.uniforms.srcRect = glGetUniformLocation(variant.id, "srcRect");
+    variant.uniforms.activeTexture = glGetUniformLocation(variant.id, "tex");
+    variant.uniforms.color = glGetUniformLocation(variant.id, "color");
+    variant.uniforms.alpha = glGetUniformLocation(variant.id, "alpha");
+    variant.uniforms.blurStep = glGetUniformLocation(variant.id, "blurStep");
+    variant.uniforms.blurWeights = glGetUniformLocation(variant.id, "blurWeights");
+    variant.uniforms.blurOffsets = glGetUniformLocation(variant.id, "blurOffsets");
+    variant.uniforms.blurTaps = glGetUniformLocation(variant.id, "blurTaps");
+    variant.synced = false;
+    return true;
 }
 
-void LPainter::LPainterPrivate::setupProgramScaler() noexcept
+void LPainter::LPainterPrivate::bindProgramVariant() noexcept
 {
-    glBindAttribLocation(currentProgram, 0, "vertexPosition");
+    const UInt8 key { programKey() };
+    ProgramVariant *variant { &programs[key] };
 
-    // Use the program object
-    glUseProgram(currentProgram);
+    if (!variant->id && !createProgramVariant(key))
+    {
+        // Keep drawing with the previous program rather than nothing
+        if (!currentVariant)
+            return;
 
-    // Load the vertex data
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, square);
+        variant = currentVariant;
+    }
 
-    // Enables the vertex array
-    glEnableVertexAttribArray(0);
+    if (currentProgram != variant->id)
+    {
+        currentProgram = variant->id;
+        glUseProgram(currentProgram);
+    }
+
+    currentVariant = variant;
+
+    // Only upload uniforms whose values differ from the ones stored in the program
+    UniformsState &s { variant->state };
+    const Uniforms &u { variant->uniforms };
+    const bool force { !variant->synced };
+    variant->synced = true;
+
+    if (state.mode == TextureMode)
+    {
+        if (force || s.srcRect != state.srcRect)
+        {
+            s.srcRect = state.srcRect;
+            glUniform4f(u.srcRect, s.srcRect.x(), s.srcRect.y(), s.srcRect.w(), s.srcRect.h());
+        }
+
+        if (force || s.activeTexture != state.activeTexture)
+        {
+            s.activeTexture = state.activeTexture;
+            glUniform1i(u.activeTexture, s.activeTexture);
+        }
+
+        if (key & BlurProgram)
+        {
+            if (force || s.blurStep != state.blurStep)
+            {
+                s.blurStep = state.blurStep;
+                glUniform2f(u.blurStep, s.blurStep.x(), s.blurStep.y());
+            }
+
+            if (force || s.blurKernelSerial != blurKernel.serial)
+            {
+                s.blurKernelSerial = blurKernel.serial;
+                glUniform1fv(u.blurWeights, blurKernel.taps, blurKernel.weights.data());
+                glUniform1fv(u.blurOffsets, blurKernel.taps, blurKernel.offsets.data());
+                glUniform1i(u.blurTaps, blurKernel.taps);
+            }
+        }
+    }
+
+    if (force || s.color != state.color)
+    {
+        s.color = state.color;
+        glUniform3f(u.color, s.color.r, s.color.g, s.color.b);
+    }
+
+    if (force || s.alpha != state.alpha)
+    {
+        s.alpha = state.alpha;
+        glUniform1f(u.alpha, s.alpha);
+    }
+}
+
+void LPainter::LPainterPrivate::setBlurKernel(Float32 radiusB) noexcept
+{
+    radiusB = std::clamp(radiusB, 1.f, MaxBlurRadiusB);
+
+    if (blurKernel.radiusB == radiusB)
+        return;
+
+    blurKernel.radiusB = radiusB;
+    blurKernel.serial++;
+
+    // Weights become negligible beyond 3 sigma
+    const Int32 radius { Int32(ceilf(radiusB)) };
+    const Float32 sigma { std::max(radiusB / 3.f, 0.5f) };
+    std::array<Float32, 2 * MaxBlurTaps> texelWeights;
+    Float32 sum { 0.f };
+
+    for (Int32 i = 0; i <= radius; i++)
+    {
+        texelWeights[i] = expf(-Float32(i * i) / (2.f * sigma * sigma));
+        sum += i == 0 ? texelWeights[i] : 2.f * texelWeights[i];
+    }
+
+    blurKernel.weights[0] = texelWeights[0] / sum;
+    blurKernel.offsets[0] = 0.f;
+    blurKernel.taps = 1;
+
+    // Pairs of texels are merged into a single bilinear sample placed at their weighted center
+    for (Int32 i = 1; i <= radius; i += 2)
+    {
+        const Float32 a { texelWeights[i] };
+        const Float32 b { i + 1 <= radius ? texelWeights[i + 1] : 0.f };
+        blurKernel.weights[blurKernel.taps] = (a + b) / sum;
+        blurKernel.offsets[blurKernel.taps] = (Float32(i) * a + Float32(i + 1) * b) / (a + b);
+        blurKernel.taps++;
+    }
+}
+
+void LPainter::LPainterPrivate::setupProgramScaler() noexcept
+{
+    // Use the program object
+    glUseProgram(currentProgram);
 
     // Get Uniform Variables
     currentUniformsScaler->texSize = glGetUniformLocation(currentProgram, "texSize");
@@ -370,6 +509,10 @@ void LPainter::LPainterPrivate::setupProgramScaler() noexcept
     currentUniformsScaler->pixelSize = glGetUniformLocation(currentProgram, "pixelSize");
     currentUniformsScaler->samplerBounds = glGetUniformLocation(currentProgram, "samplerBounds");
     currentUniformsScaler->iters = glGetUniformLocation(currentProgram, "iters");
+    currentUniformsScaler->mode = glGetUniformLocation(currentProgram, "mode");
+
+    // Scaler programs only use the legacy mode
+    glUniform1i(currentUniformsScaler->mode, LegacyMode);
 }
 
 void LPainter::LPainterPrivate::updateExtensions() noexcept
@@ -377,6 +520,39 @@ void LPainter::LPainterPrivate::updateExtensions() noexcept
     const char *exts = (const char*)glGetString(GL_EXTENSIONS);
     openGLExtensions.EXT_read_format_bgra = LOpenGL::hasExtension(exts, "GL_EXT_read_format_bgra");
     openGLExtensions.OES_EGL_image = LOpenGL::hasExtension(exts, "GL_OES_EGL_image");
+    openGLExtensions.OES_texture_npot = LOpenGL::hasExtension(exts, "GL_OES_texture_npot");
+    openGLExtensions.EXT_disjoint_timer_query = LOpenGL::hasExtension(exts, "GL_EXT_disjoint_timer_query");
+}
+
+bool LPainter::LPainterPrivate::updateMipmaps(LTexture *texture, GLuint id) noexcept
+{
+    // glGenerateMipmap() respecifies the texture, which would orphan imported buffers (DMA, wl_drm, native) from their EGLImage
+    if (texture->sourceType() != LTexture::CPU && texture->sourceType() != LTexture::Framebuffer)
+        return false;
+
+    const LSize &size { texture->sizeB() };
+
+    // GLES 2.0 only supports mipmaps for NPOT textures with GL_OES_texture_npot
+    if (!openGLExtensions.OES_texture_npot && ((size.w() & (size.w() - 1)) || (size.h() & (size.h() - 1))))
+        return false;
+
+    for (auto &state : texture->m_mipmapStates)
+    {
+        if (state.output == output && state.id == id)
+        {
+            if (state.serial != texture->serial())
+            {
+                state.serial = texture->serial();
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+
+            return true;
+        }
+    }
+
+    texture->m_mipmapStates.push_back({ output, id, texture->serial() });
+    glGenerateMipmap(GL_TEXTURE_2D);
+    return true;
 }
 
 void LPainter::LPainterPrivate::updateCPUFormats() noexcept
@@ -664,9 +840,22 @@ void LPainter::bindTextureMode(const TextureParams &p) noexcept
 
     srcFbX1 *= fbScale;
     srcFbY1 *= fbScale;
+    srcFbX2 *= fbScale;
+    srcFbY2 *= fbScale;
 
-    srcFbW = srcFbX2 * fbScale - srcFbX1;
-    srcFbH = srcFbY2 * fbScale - srcFbY1;
+    /* When rendering directly with a fractional scale (without oversampling), snap the texture edges
+     * to framebuffer pixels the same way setViewport() does. This keeps texels aligned to pixels
+     * for buffers rendered at the fractional scale and avoids sampling across edges */
+    if (fbScale != floorf(fbScale))
+    {
+        srcFbX1 = floorf(srcFbX1);
+        srcFbY1 = floorf(srcFbY1);
+        srcFbX2 = floorf(srcFbX2);
+        srcFbY2 = floorf(srcFbY2);
+    }
+
+    srcFbW = srcFbX2 - srcFbX1;
+    srcFbH = srcFbY2 - srcFbY1;
 
     imp()->srcRect.setX(srcFbX1);
     imp()->srcRect.setY(srcFbY1);
@@ -676,8 +865,23 @@ void LPainter::bindTextureMode(const TextureParams &p) noexcept
     glActiveTexture(GL_TEXTURE0);
     imp()->shaderSetMode(LPainterPrivate::TextureMode);
     imp()->shaderSetActiveTexture(0);
-    glBindTexture(target, p.texture->id(imp()->output));
-    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    const GLuint textureId { p.texture->id(imp()->output) };
+    glBindTexture(target, textureId);
+
+    GLint minFilter { GL_LINEAR };
+
+    if ((p.mipmapFiltering || p.texture->mipmapsEnabled()) && target == GL_TEXTURE_2D)
+    {
+        // Only worth it if more than one texel is mapped to each framebuffer pixel
+        const bool downscaled {
+            srcRectW * p.srcScale > Float32(p.dstSize.w()) * fbScale ||
+            srcRectH * p.srcScale > Float32(p.dstSize.h()) * fbScale };
+
+        if (downscaled && imp()->updateMipmaps(p.texture, textureId))
+            minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    }
+
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
     glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -698,6 +902,7 @@ void LPainter::drawBox(const LBox &box) noexcept
         imp()->updateBlendingParams();
 
     imp()->setViewport(box.x1, box.y1, box.x2 - box.x1, box.y2 - box.y1);
+    imp()->bindProgramVariant();
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
@@ -707,6 +912,7 @@ void LPainter::drawRect(const LRect &rect) noexcept
         imp()->updateBlendingParams();
 
     imp()->setViewport(rect.x(), rect.y(), rect.w(), rect.h());
+    imp()->bindProgramVariant();
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
@@ -723,6 +929,7 @@ void LPainter::drawRegion(const LRegion &region) noexcept
                            box->y1,
                            box->x2 - box->x1,
                            box->y2 - box->y1);
+        imp()->bindProgramVariant();
         glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
         box++;
     }
@@ -844,7 +1051,9 @@ void LPainter::clearScreen() noexcept
 
 void LPainter::bindProgram() noexcept
 {
-    glUseProgram(imp()->programObject);
+    // Force a rebind, the user may have changed the current program
+    imp()->currentProgram = 0;
+    imp()->bindProgramVariant();
 }
 
 void LPainter::setBlendFunc(const LBlendFunc &blendFunc) const noexcept
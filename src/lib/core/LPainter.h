@@ -76,6 +76,13 @@ public:
          * @brief Scale factor of the texture.
          */
         Float32 srcScale { 1.f };
+
+        /**
+         * @brief Samples a mipmap chain when the texture is downscaled.
+         *
+         * Has the same effect as LTexture::enableMipmaps() but only for this draw.
+         */
+        bool mipmapFiltering { false };
     };
 
     /**
@@ -1,29 +1,73 @@
 #include <LRegion.h>
+#include <vector>
 
 using namespace Louvre;
 
-void LRegion::multiply(Float32 factor) noexcept
+// Boxes of the region being rebuilt, kept to avoid reallocating them on each call
+static thread_local std::vector<pixman_box32_t> boxesScratch;
+
+static void pushBox(Int32 x, Int32 y, Int32 w, Int32 h) noexcept
 {
-    if (factor == 1.f)
-        return;
+    if (w > 0 && h > 0)
+        boxesScratch.push_back({ x, y, x + w, y + h });
+}
+
+pixman_region32_t *LRegion::scratch() noexcept
+{
+    struct ScratchRegion
+    {
+        ScratchRegion() noexcept { pixman_region32_init(&region); }
+        ~ScratchRegion() noexcept { pixman_region32_fini(&region); }
+        pixman_region32_t region;
+    };
+
+    static thread_local ScratchRegion scratch;
+    return &scratch.region;
+}
 
-    pixman_region32_t tmp;
-    pixman_region32_init(&tmp);
+void LRegion::setBoxes(const pixman_box32_t *boxes, Int32 n) noexcept
+{
+    // Overlapping boxes are merged by pixman
+    pixman_region32_fini(&m_region);
+    pixman_region32_init_rects(&m_region, boxes, n);
+
+    if (hasStorage(m_region))
+        m_allocations++;
+}
+
+void LRegion::expand(Int32 amount) noexcept
+{
+    if (amount <= 0)
+        return;
 
     int n;
     const pixman_box32_t *rects { pixman_region32_rectangles(&m_region, &n) };
 
+    if (n == 0)
+        return;
+
+    boxesScratch.clear();
+
+    for (int i = 0; i < n; i++)
+        boxesScratch.push_back({ rects[i].x1 - amount, rects[i].y1 - amount, rects[i].x2 + amount, rects[i].y2 + amount });
+
+    setBoxes(boxesScratch.data(), n);
+}
+
+static void multiplyBoxes(pixman_region32_t *region, Float32 factor) noexcept
+{
+    int n;
+    const pixman_box32_t *rects { pixman_region32_rectangles(region, &n) };
+    boxesScratch.clear();
+
     if (factor == 0.5f)
     {
         for (int i = 0; i < n; i++)
         {
-            pixman_region32_union_rect(
-                        &tmp,
-                        &tmp,
-                        rects->x1 >> 1,
-                        rects->y1 >> 1,
-                        (rects->x2 - rects->x1) >> 1,
-                        (rects->y2 - rects->y1) >> 1);
+            pushBox(rects->x1 >> 1,
+                    rects->y1 >> 1,
+                    (rects->x2 - rects->x1) >> 1,
+                    (rects->y2 - rects->y1) >> 1);
             rects++;
         }
     }
@@ -31,13 +75,10 @@ void LRegion::multiply(Float32 factor) noexcept
     {
         for (int i = 0; i < n; i++)
         {
-            pixman_region32_union_rect(
-                        &tmp,
-                        &tmp,
-                        rects->x1 << 1,
-                        rects->y1 << 1,
-                        (rects->x2 - rects->x1) << 1,
-                        (rects->y2 - rects->y1) << 1);
+            pushBox(rects->x1 << 1,
+                    rects->y1 << 1,
+                    (rects->x2 - rects->x1) << 1,
+                    (rects->y2 - rects->y1) << 1);
             rects++;
         }
     }
@@ -45,19 +86,22 @@ void LRegion::multiply(Float32 factor) noexcept
     {
         for (int i = 0; i < n; i++)
         {
-            pixman_region32_union_rect(
-                &tmp,
-                &tmp,
-                floorf(float(rects->x1) * factor),
-                floorf(float(rects->y1) * factor),
-                ceilf(float(rects->x2 - rects->x1) * factor),
-                ceilf(float(rects->y2 - rects->y1) * factor));
+            pushBox(floorf(float(rects->x1) * factor),
+                    floorf(float(rects->y1) * factor),
+                    ceilf(float(rects->x2 - rects->x1) * factor),
+                    ceilf(float(rects->y2 - rects->y1) * factor));
             rects++;
         }
     }
+}
 
-    pixman_region32_fini(&m_region);
-    m_region = tmp;
+void LRegion::multiply(Float32 factor) noexcept
+{
+    if (factor == 1.f)
+        return;
+
+    multiplyBoxes(&m_region, factor);
+    setBoxes(boxesScratch.data(), boxesScratch.size());
 }
 
 void LRegion::multiply(Float32 xFactor, Float32 yFactor) noexcept
@@ -65,137 +109,64 @@ void LRegion::multiply(Float32 xFactor, Float32 yFactor) noexcept
     if (xFactor == 1.f && yFactor == 1.f)
         return;
 
-    pixman_region32_t tmp;
-    pixman_region32_init(&tmp);
-
     int n;
     const pixman_box32_t *rects { pixman_region32_rectangles(&m_region, &n) };
+    boxesScratch.clear();
 
     for (int i = 0; i < n; i++)
     {
-        pixman_region32_union_rect(
-            &tmp,
-            &tmp,
-            floor(float(rects->x1) * xFactor),
-            floor(float(rects->y1) * yFactor),
-            ceil(float(rects->x2 - rects->x1) * xFactor),
-            ceil(float(rects->y2 - rects->y1) * yFactor));
+        pushBox(floor(float(rects->x1) * xFactor),
+                floor(float(rects->y1) * yFactor),
+                ceil(float(rects->x2 - rects->x1) * xFactor),
+                ceil(float(rects->y2 - rects->y1) * yFactor));
         rects++;
     }
 
-    pixman_region32_fini(&m_region);
-    m_region = tmp;
+    setBoxes(boxesScratch.data(), boxesScratch.size());
 }
 
 void LRegion::transform(const LSize &size, LTransform transform) noexcept
 {
-    pixman_region32_intersect_rect(&m_region, &m_region, 0, 0, size.w(), size.h());
+    clip(0, 0, size.w(), size.h());
 
-    LBox *boxes;
-    Int32 n, i;
-    pixman_region32_t tmp;
+    if (transform <= LTransform::Normal || transform > LTransform::Flipped270)
+        return;
 
-    switch (transform)
+    Int32 n;
+    const LBox *box { boxes(&n) };
+    boxesScratch.clear();
+
+    for (Int32 i = 0; i < n; i++, box++)
     {
-    case LTransform::Normal:
-        return;
-    case LTransform::Flipped270:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       size.h() - boxes->y2,
-                                       size.w() - boxes->x2,
-                                       boxes->y2 - boxes->y1,
-                                       boxes->x2 - boxes->x1);
-            boxes++;
-        }
-        break;
-    case LTransform::Flipped90:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       boxes->y1,
-                                       boxes->x1,
-                                       boxes->y2 - boxes->y1,
-                                       boxes->x2 - boxes->x1);
-            boxes++;
-        }
-        break;
-    case LTransform::Flipped180:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       boxes->x1,
-                                       size.h() - boxes->y2,
-                                       boxes->x2 - boxes->x1,
-                                       boxes->y2 - boxes->y1);
-            boxes++;
-        }
-        break;
-    case LTransform::Rotated180:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       size.w() - boxes->x2,
-                                       size.h() - boxes->y2,
-                                       boxes->x2 - boxes->x1,
-                                       boxes->y2 - boxes->y1);
-            boxes++;
-        }
-        break;
-    case LTransform::Flipped:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       size.w() - boxes->x2,
-                                       boxes->y1,
-                                       boxes->x2 - boxes->x1,
-                                       boxes->y2 - boxes->y1);
-            boxes++;
-        }
-        break;
-    case LTransform::Rotated90:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       boxes->y1,
-                                       size.w() - boxes->x2,
-                                       boxes->y2 - boxes->y1,
-                                       boxes->x2 - boxes->x1);
-            boxes++;
-        }
-        break;
-    case LTransform::Rotated270:
-        pixman_region32_init(&tmp);
-        boxes = (LBox*)pixman_region32_rectangles(&m_region, &n);
-        for (i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(&tmp, &tmp,
-                                       size.h() - boxes->y2,
-                                       boxes->x1,
-                                       boxes->y2 - boxes->y1,
-                                       boxes->x2 - boxes->x1);
-            boxes++;
+        switch (transform)
+        {
+        case LTransform::Flipped270:
+            pushBox(size.h() - box->y2, size.w() - box->x2, box->y2 - box->y1, box->x2 - box->x1);
+            break;
+        case LTransform::Flipped90:
+            pushBox(box->y1, box->x1, box->y2 - box->y1, box->x2 - box->x1);
+            break;
+        case LTransform::Flipped180:
+            pushBox(box->x1, size.h() - box->y2, box->x2 - box->x1, box->y2 - box->y1);
+            break;
+        case LTransform::Rotated180:
+            pushBox(size.w() - box->x2, size.h() - box->y2, box->x2 - box->x1, box->y2 - box->y1);
+            break;
+        case LTransform::Flipped:
+            pushBox(size.w() - box->x2, box->y1, box->x2 - box->x1, box->y2 - box->y1);
+            break;
+        case LTransform::Rotated90:
+            pushBox(box->y1, size.w() - box->x2, box->y2 - box->y1, box->x2 - box->x1);
+            break;
+        case LTransform::Rotated270:
+            pushBox(size.h() - box->y2, box->x1, box->y2 - box->y1, box->x2 - box->x1);
+            break;
+        default:
+            break;
         }
-        break;
-    default:
-        return;
     }
 
-    pixman_region32_fini(&m_region);
-    m_region = tmp;
+    setBoxes(boxesScratch.data(), boxesScratch.size());
 }
 
 LPointF LRegion::closestPointFrom(const LPointF &point, Float32 margin) const noexcept
@@ -267,51 +238,6 @@ void LRegion::multiply(LRegion *dst, LRegion *src, Float32 factor) noexcept
         return;
     }
 
-    pixman_region32_clear(&dst->m_region);
-
-    int n;
-    const pixman_box32_t *rects { pixman_region32_rectangles(&src->m_region, &n) };
-
-    if (factor == 0.5f)
-    {
-        for (int i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(
-                &dst->m_region,
-                &dst->m_region,
-                rects->x1 >> 1,
-                rects->y1 >> 1,
-                (rects->x2 - rects->x1) >> 1,
-                (rects->y2 - rects->y1) >> 1);
-            rects++;
-        }
-    }
-    else if (factor == 2.f)
-    {
-        for (int i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(
-                &dst->m_region,
-                &dst->m_region,
-                rects->x1 << 1,
-                rects->y1 << 1,
-                (rects->x2 - rects->x1) << 1,
-                (rects->y2 - rects->y1) << 1);
-            rects++;
-        }
-    }
-    else
-    {
-        for (int i = 0; i < n; i++)
-        {
-            pixman_region32_union_rect(
-                &dst->m_region,
-                &dst->m_region,
-                floor(float(rects->x1) * factor),
-                floor(float(rects->y1) * factor),
-                ceil(float(rects->x2 - rects->x1) * factor),
-                ceil(float(rects->y2 - rects->y1) * factor));
-            rects++;
-        }
-    }
+    multiplyBoxes(&src->m_region, factor);
+    dst->setBoxes(boxesScratch.data(), boxesScratch.size());
 }
@@ -5,6 +5,7 @@
 #include <LBox.h>
 #include <LTransform.h>
 #include <pixman.h>
+#include <utility>
 
 /**
  * @brief Collection of non-overlapping rectangles
@@ -50,6 +51,9 @@ public:
     {
         pixman_region32_init(&m_region);
         pixman_region32_copy(&m_region, &other.m_region);
+
+        if (hasStorage(m_region))
+            m_allocations++;
     }
 
     /**
@@ -75,7 +79,7 @@ public:
     LRegion &operator=(const LRegion &other) noexcept
     {
         if (&other != this)
-            pixman_region32_copy(&m_region, &other.m_region);
+            apply(false, [&other](pixman_region32_t *dst) { pixman_region32_copy(dst, &other.m_region); });
         return *this;
     }
 
@@ -99,12 +103,28 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Returns true if both regions contain exactly the same area.
+     */
+    bool operator==(const LRegion &other) const noexcept
+    {
+        return pixman_region32_equal(&m_region, &other.m_region);
+    }
+
     /**
      * @brief Clears the LRegion, deleting all rectangles.
+     *
+     * The box storage is kept, so refilling the region doesn't require allocating it again.
      */
     void clear() noexcept
     {
-        pixman_region32_clear(&m_region);
+        if (hasStorage(m_region))
+        {
+            m_region.data->numRects = 0;
+            m_region.extents = { 0, 0, 0, 0 };
+        }
+        else
+            pixman_region32_clear(&m_region);
     }
 
     /**
@@ -114,7 +134,7 @@ public:
      */
     void addRect(const LRect &rect) noexcept
     {
-        pixman_region32_union_rect(&m_region, &m_region, rect.x(), rect.y(), rect.w(), rect.h());
+        addRect(rect.x(), rect.y(), rect.w(), rect.h());
     }
 
     /**
@@ -125,7 +145,7 @@ public:
      */
     void addRect(const LPoint &pos, const LSize &size) noexcept
     {
-        pixman_region32_union_rect(&m_region, &m_region, pos.x(), pos.y(), size.w(), size.h());
+        addRect(pos.x(), pos.y(), size.w(), size.h());
     }
 
     /**
@@ -137,7 +157,7 @@ public:
      */
     void addRect(Int32 x, Int32 y, const LSize &size) noexcept
     {
-        pixman_region32_union_rect(&m_region, &m_region, x, y, size.w(), size.h());
+        addRect(x, y, size.w(), size.h());
     }
 
     /**
@@ -149,7 +169,7 @@ public:
      */
     void addRect(const LPoint &pos, Int32 w, Int32 h) noexcept
     {
-        pixman_region32_union_rect(&m_region, &m_region, pos.x(), pos.y(), w, h);
+        addRect(pos.x(), pos.y(), w, h);
     }
 
     /**
@@ -162,7 +182,7 @@ public:
      */
     void addRect(Int32 x, Int32 y, Int32 w, Int32 h) noexcept
     {
-        pixman_region32_union_rect(&m_region, &m_region, x, y, w, h);
+        apply(hasStorage(m_region), [&](pixman_region32_t *dst) { pixman_region32_union_rect(dst, &m_region, x, y, w, h); });
     }
 
     /**
@@ -173,7 +193,9 @@ public:
     void addRegion(const LRegion &region) noexcept
     {
         if (&region != this)
-            pixman_region32_union(&m_region, &m_region, &region.m_region);
+            apply(hasStorage(m_region) || hasStorage(region.m_region), [&](pixman_region32_t *dst) {
+                pixman_region32_union(dst, &m_region, &region.m_region);
+            });
     }
 
     /**
@@ -183,10 +205,7 @@ public:
      */
     void subtractRect(const LRect &rect) noexcept
     {
-        pixman_region32_t tmp;
-        pixman_region32_init_rect(&tmp, rect.x(), rect.y(), rect.w(), rect.h());
-        pixman_region32_subtract(&m_region, &m_region, &tmp);
-        pixman_region32_fini(&tmp);        
+        subtractRect(rect.x(), rect.y(), rect.w(), rect.h());
     }
 
     /**
@@ -197,10 +216,7 @@ public:
      */
     void subtractRect(const LPoint &pos, const LSize &size) noexcept
     {
-        pixman_region32_t tmp;
-        pixman_region32_init_rect(&tmp, pos.x(), pos.y(), size.w(), size.h());
-        pixman_region32_subtract(&m_region, &m_region, &tmp);
-        pixman_region32_fini(&tmp);
+        subtractRect(pos.x(), pos.y(), size.w(), size.h());
     }
 
     /**
@@ -212,10 +228,7 @@ public:
      */
     void subtractRect(const LPoint &pos, Int32 w, Int32 h) noexcept
     {
-        pixman_region32_t tmp;
-        pixman_region32_init_rect(&tmp, pos.x(), pos.y(), w, h);
-        pixman_region32_subtract(&m_region, &m_region, &tmp);
-        pixman_region32_fini(&tmp);
+        subtractRect(pos.x(), pos.y(), w, h);
     }
 
     /**
@@ -227,10 +240,7 @@ public:
      */
     void subtractRect(Int32 x, Int32 y, const LSize &size) noexcept
     {
-        pixman_region32_t tmp;
-        pixman_region32_init_rect(&tmp, x, y, size.w(), size.h());
-        pixman_region32_subtract(&m_region, &m_region, &tmp);
-        pixman_region32_fini(&tmp);
+        subtractRect(x, y, size.w(), size.h());
     }
 
     /**
@@ -245,7 +255,7 @@ public:
     {
         pixman_region32_t tmp;
         pixman_region32_init_rect(&tmp, x, y, w, h);
-        pixman_region32_subtract(&m_region, &m_region, &tmp);
+        apply(hasStorage(m_region), [&](pixman_region32_t *dst) { pixman_region32_subtract(dst, &m_region, &tmp); });
         pixman_region32_fini(&tmp);
     }
 
@@ -256,7 +266,7 @@ public:
      */
     void subtractRegion(const LRegion &region) noexcept
     {
-        pixman_region32_subtract(&m_region, &m_region, &region.m_region);
+        apply(hasStorage(m_region), [&](pixman_region32_t *dst) { pixman_region32_subtract(dst, &m_region, &region.m_region); });
     }
 
     /**
@@ -267,7 +277,9 @@ public:
     void intersectRegion(const LRegion &region) noexcept
     {
         if (&region != this)
-            pixman_region32_intersect(&m_region, &m_region, &region.m_region);
+            apply(hasStorage(m_region) || hasStorage(region.m_region), [&](pixman_region32_t *dst) {
+                pixman_region32_intersect(dst, &m_region, &region.m_region);
+            });
     }
 
     /**
@@ -285,6 +297,15 @@ public:
      */
     void multiply(Float32 xFactor, Float32 yFactor) noexcept;
 
+    /**
+     * @brief Grows each rectangle of the LRegion by the given amount on all sides.
+     *
+     * Useful for example to find the area affected by a filter with the given radius.
+     *
+     * @param amount Number of units to grow, negative values are ignored.
+     */
+    void expand(Int32 amount) noexcept;
+
     /**
     * @brief Check if the LRegion contains a specific point.
      *
@@ -296,6 +317,22 @@ public:
         return pixman_region32_contains_point(&m_region, point.x(), point.y(), NULL);
     }
 
+    /**
+     * @brief Check if the LRegion fully contains a box.
+     *
+     * Unlike subtracting the box and checking if the result is empty, this doesn't modify nor allocate any region.
+     *
+     * @param box The box to check, empty boxes are never contained.
+     * @return true if every point of the box is inside the region, false otherwise.
+     */
+    bool containsBox(const LBox &box) const noexcept
+    {
+        if (box.x1 >= box.x2 || box.y1 >= box.y2)
+            return false;
+
+        return pixman_region32_contains_rectangle(&m_region, (pixman_box32_t*)&box) == PIXMAN_REGION_IN;
+    }
+
     /**
      * @brief Translate each rectangle in the LRegion by the specified offset.
      *
@@ -337,7 +374,7 @@ public:
             rect.y() + rect.h()
         };
 
-        pixman_region32_inverse(&m_region, &m_region, &r);
+        apply(hasStorage(m_region), [&](pixman_region32_t *dst) { pixman_region32_inverse(dst, &m_region, &r); });
     }
 
     /**
@@ -357,7 +394,7 @@ public:
      */
     void clip(const LRect &rect) noexcept
     {
-        pixman_region32_intersect_rect(&m_region, &m_region, rect.x(), rect.y(), rect.w(), rect.h());
+        clip(rect.x(), rect.y(), rect.w(), rect.h());
     }
 
     /**
@@ -365,7 +402,7 @@ public:
      */
     void clip(const LPoint &pos, const LSize &size) noexcept
     {
-        pixman_region32_intersect_rect(&m_region, &m_region, pos.x(), pos.y(), size.w(), size.h());
+        clip(pos.x(), pos.y(), size.w(), size.h());
     }
 
     /**
@@ -373,7 +410,7 @@ public:
      */
     void clip(Int32 x, Int32 y, Int32 w, Int32 h) noexcept
     {
-        pixman_region32_intersect_rect(&m_region, &m_region, x, y, w, h);
+        apply(hasStorage(m_region), [&](pixman_region32_t *dst) { pixman_region32_intersect_rect(dst, &m_region, x, y, w, h); });
     }
 
     /**
@@ -453,7 +490,54 @@ public:
     }
 
     static void multiply(LRegion *dst, LRegion *src, Float32 factor) noexcept;
+
+    /**
+     * @brief Number of box storage allocations made by LRegion operations on the calling thread.
+     *
+     * Regions keep their box storage when cleared, and in-place operations on regions with box storage write into a
+     * per-thread scratch region and swap storages with it, instead of pixman allocating a new one each time.
+     * This counter can be used to verify that, for example, the damage tracking of a steady scene doesn't allocate.
+     *
+     * @note Operations performed directly on `m_region` with pixman functions aren't counted.
+     */
+    static UInt64 allocationsCount() noexcept
+    {
+        return m_allocations;
+    }
+
     mutable pixman_region32_t m_region;
+
+private:
+    static inline thread_local UInt64 m_allocations { 0 };
+
+    // Returns the scratch region of the calling thread, see allocationsCount()
+    static pixman_region32_t *scratch() noexcept;
+
+    // Replaces the content with the union of the given boxes
+    void setBoxes(const pixman_box32_t *boxes, Int32 n) noexcept;
+
+    static bool hasStorage(const pixman_region32_t &region) noexcept
+    {
+        return region.data && region.data->size > 0;
+    }
+
+    /* Runs op(dst) where dst is either this region or, if useScratch, the scratch region whose storage
+     * is then swapped with this one. pixman always allocates when the destination is also a multi-box operand */
+    template<class Op>
+    void apply(bool useScratch, Op op) noexcept
+    {
+        pixman_region32_t *dst { useScratch ? scratch() : &m_region };
+        const pixman_region32_data_t *prevData { dst->data };
+        const long prevSize { hasStorage(*dst) ? dst->data->size : 0 };
+
+        op(dst);
+
+        if (hasStorage(*dst) && (dst->data != prevData || dst->data->size > prevSize))
+            m_allocations++;
+
+        if (dst != &m_region)
+            std::swap(*dst, m_region);
+    }
 };
 
 #endif // LREGION_H
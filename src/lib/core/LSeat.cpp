@@ -87,6 +87,53 @@ bool LSeat::isUserIdleHint() const noexcept
     return imp()->isUserIdleHint;
 }
 
+void LSeat::enablePointerEventCoalescing(bool enabled) noexcept
+{
+    if (!enabled)
+        imp()->flushPendingPointerEvents();
+
+    imp()->pointerEventCoalescing = enabled;
+}
+
+bool LSeat::pointerEventCoalescingEnabled() const noexcept
+{
+    return imp()->pointerEventCoalescing;
+}
+
+void LSeat::enablePointerLatencyTracing(bool enabled) noexcept
+{
+    if (imp()->pointerLatencyTracing == enabled)
+        return;
+
+    imp()->pointerLatencyTracing = enabled;
+    imp()->pendingLatencyFlush = imp()->pendingLatencyPageFlip = false;
+}
+
+bool LSeat::pointerLatencyTracingEnabled() const noexcept
+{
+    return imp()->pointerLatencyTracing;
+}
+
+const LLatencyHistogram &LSeat::pointerLatency(PointerLatencyStage stage) const noexcept
+{
+    return imp()->pointerLatency[stage];
+}
+
+void LSeat::resetPointerLatency() noexcept
+{
+    for (auto &histogram : imp()->pointerLatency)
+        histogram.reset();
+
+    imp()->pendingLatencyFlush = imp()->pendingLatencyPageFlip = false;
+}
+
+void LSeat::logPointerLatency() const noexcept
+{
+    imp()->pointerLatency[HandlerLatency].log("Pointer latency: input -> handler");
+    imp()->pointerLatency[FlushLatency].log("Pointer latency: input -> client flush");
+    imp()->pointerLatency[PageFlipLatency].log("Pointer latency: input -> page flip");
+}
+
 const char *LSeat::name() const noexcept
 {
     if (imp()->libseatHandle)
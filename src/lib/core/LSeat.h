@@ -97,6 +97,86 @@ public:
      */
     bool isUserIdleHint() const noexcept;
 
+    /**
+     * @brief Enables or disables pointer event coalescing.
+     *
+     * High polling rate mice can generate thousands of motion events per second, far more than any output can display.
+     * When enabled, consecutive pointer move and scroll events are merged (their deltas accumulated) and kept pending until an output
+     * is about to render or presented a frame, when they are delivered on the main thread, roughly once per refresh.
+     * This is a best-effort burst merge: if the main thread doesn't get the chance to deliver them before the frame starts, they are
+     * included in the following one.\n
+     * Interleaved moves and scrolls are merged separately, and the first one queued is delivered first. Any other pointer or keyboard event
+     * flushes the pending ones first.
+     *
+     * @note Coalesced events are also notified through onEvent() only when delivered. Scroll events where an axis drops to zero, which
+     *       are sent as scroll stops, are never merged.
+     *
+     * Disabled by default.
+     */
+    void enablePointerEventCoalescing(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if pointer event coalescing is enabled.
+     *
+     * @see enablePointerEventCoalescing()
+     */
+    bool pointerEventCoalescingEnabled() const noexcept;
+
+    /**
+     * @brief Pointer latency tracing stages.
+     *
+     * Each stage measures the time elapsed since the input device generated the event, using its LInputEvent::us() timestamp.
+     *
+     * @see pointerLatency()
+     */
+    enum PointerLatencyStage : UInt8
+    {
+        /// Until the LPointer event handler is called
+        HandlerLatency  = 0,
+
+        /// Until the events sent to clients are flushed
+        FlushLatency    = 1,
+
+        /// Until the next page flip of the output the cursor is on
+        PageFlipLatency = 2
+    };
+
+    /**
+     * @brief Enables or disables pointer latency tracing.
+     *
+     * When enabled, the latency of pointer move, scroll and button events is recorded into a histogram for each @ref PointerLatencyStage.\n
+     * Each flush and page flip sample is measured from the oldest event not accounted for yet.
+     *
+     * Disabled by default.
+     *
+     * @see pointerLatency()
+     */
+    void enablePointerLatencyTracing(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if pointer latency tracing is enabled.
+     *
+     * @see enablePointerLatencyTracing()
+     */
+    bool pointerLatencyTracingEnabled() const noexcept;
+
+    /**
+     * @brief Pointer latency histogram of the given stage.
+     *
+     * @see enablePointerLatencyTracing()
+     */
+    const LLatencyHistogram &pointerLatency(PointerLatencyStage stage) const noexcept;
+
+    /**
+     * @brief Clears all pointer latency histograms.
+     */
+    void resetPointerLatency() noexcept;
+
+    /**
+     * @brief Prints all pointer latency histograms using LLog::log().
+     */
+    void logPointerLatency() const noexcept;
+
     /**
      * @brief The seat name
      *
@@ -426,12 +426,17 @@ void LSurface::requestNextFrame(bool clearDamage) noexcept
         imp()->stateFlags.remove(LSurfacePrivate::Damaged);
     }
 
+    if (imp()->frameCallbacks.empty() || !imp()->frameCallbacks.front()->m_commited)
+        return;
+
+    imp()->lastFrameCallbackMs = LTime::ms();
+
     while (!imp()->frameCallbacks.empty())
     {
         if (!imp()->frameCallbacks.front()->m_commited)
             break;
 
-        imp()->frameCallbacks.front()->done(LTime::ms());
+        imp()->frameCallbacks.front()->done(imp()->lastFrameCallbackMs);
         imp()->frameCallbacks.front()->destroy();
     }
 }
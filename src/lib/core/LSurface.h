@@ -845,7 +845,10 @@ public:
      * @brief Notifies when the surface changes its position in the surfaces list
      *
      * Override this virtual method if you wish to be informed about changes in the order of the surface within
-     * the compositor's list of surfaces.
+     * the compositor's list of surfaces.\n
+     * Changes are collected while processing client requests and notified once at the end of each main loop
+     * iteration, from bottom to top, and only to surfaces whose prevSurface() changed since their last notification
+     * (or whose parent changed). Surfaces that merely shift position because others moved are not notified.
      *
      * #### Default Implementation
      * @snippet LSurfaceDefault.cpp orderChanged
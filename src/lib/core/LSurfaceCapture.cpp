@@ -0,0 +1,265 @@
+#include <private/LCompositorPrivate.h>
+#include <LSurfaceCapture.h>
+#include <LRenderBuffer.h>
+#include <LSurface.h>
+#include <LPainter.h>
+#include <LUtils.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace Louvre;
+
+// Max unused render targets kept alive
+static constexpr size_t maxPoolSize { 8 };
+
+static LRenderBuffer *acquireBuffer(const LSize &sizeB) noexcept
+{
+    auto &pool { compositor()->imp()->surfaceCapturePool };
+
+    if (pool.empty())
+        return new LRenderBuffer(sizeB);
+
+    // Prefer a buffer with the same size to avoid reallocating its storage
+    auto it { std::find_if(pool.begin(), pool.end(), [&sizeB](LRenderBuffer *buffer) { return buffer->sizeB() == sizeB; }) };
+
+    if (it == pool.end())
+        it = std::prev(pool.end());
+
+    LRenderBuffer *buffer { *it };
+    pool.erase(it);
+    buffer->setSizeB(sizeB);
+    return buffer;
+}
+
+static void releaseBuffer(LRenderBuffer *buffer) noexcept
+{
+    auto &pool { compositor()->imp()->surfaceCapturePool };
+
+    if (pool.size() >= maxPoolSize)
+    {
+        delete pool.front();
+        pool.erase(pool.begin());
+    }
+
+    pool.push_back(buffer);
+}
+
+LSurfaceCapture::LSurfaceCapture(LSurface *surface, Float32 scale) noexcept
+{
+    setSurface(surface);
+    setScale(scale);
+}
+
+LSurfaceCapture::~LSurfaceCapture() noexcept
+{
+    release();
+}
+
+void LSurfaceCapture::setSurface(LSurface *surface) noexcept
+{
+    if (m_surface.get() == surface)
+        return;
+
+    m_surface.reset(surface);
+    m_needsFullRender = true;
+}
+
+void LSurfaceCapture::setScale(Float32 scale) noexcept
+{
+    if (scale < 0.1f)
+        scale = 0.1f;
+
+    if (m_scale == scale)
+        return;
+
+    m_scale = scale;
+    m_needsFullRender = true;
+}
+
+LTexture *LSurfaceCapture::texture() const noexcept
+{
+    return m_buffer ? m_buffer->texture() : nullptr;
+}
+
+void LSurfaceCapture::release() noexcept
+{
+    if (!m_buffer)
+        return;
+
+    releaseBuffer(m_buffer);
+    m_buffer = nullptr;
+    m_needsFullRender = true;
+}
+
+void LSurfaceCapture::clearPool() noexcept
+{
+    auto &pool { compositor()->imp()->surfaceCapturePool };
+
+    while (!pool.empty())
+    {
+        delete pool.back();
+        pool.pop_back();
+    }
+}
+
+void LSurfaceCapture::collect(LSurface *root) noexcept
+{
+    // Subsurfaces can be stacked below their parent, so follow the global order
+    for (LSurface *s : compositor()->surfaces())
+    {
+        if (!s->mapped() || !s->texture())
+            continue;
+
+        if (s != root)
+        {
+            LSurface *parent { s };
+
+            while (parent && parent != root && parent->subsurface())
+                parent = parent->parent();
+
+            if (parent != root)
+                continue;
+        }
+
+        m_entries.push_back({ s, s->damageId(), LRect(s->rolePos() - root->rolePos(), s->size()) });
+    }
+}
+
+bool LSurfaceCapture::update() noexcept
+{
+    LPainter *painter { compositor()->imp()->findPainter() };
+
+    if (!painter || !surface() || !surface()->mapped())
+        return false;
+
+    std::swap(m_entries, m_prevEntries);
+    m_entries.clear();
+    collect(surface());
+
+    LBox bounds { 0, 0, 0, 0 };
+
+    for (const Entry &e : m_entries)
+    {
+        const LBox box { e.rect.x(), e.rect.y(), e.rect.x() + e.rect.w(), e.rect.y() + e.rect.h() };
+
+        if (&e == &m_entries.front())
+        {
+            bounds = box;
+            continue;
+        }
+
+        bounds.x1 = std::min(bounds.x1, box.x1);
+        bounds.y1 = std::min(bounds.y1, box.y1);
+        bounds.x2 = std::max(bounds.x2, box.x2);
+        bounds.y2 = std::max(bounds.y2, box.y2);
+    }
+
+    const LRect rect { bounds.x1, bounds.y1, bounds.x2 - bounds.x1, bounds.y2 - bounds.y1 };
+    const LSize sizeB { Int32(ceilf(Float32(rect.w()) * m_scale)), Int32(ceilf(Float32(rect.h()) * m_scale)) };
+
+    if (!m_buffer)
+    {
+        m_buffer = acquireBuffer(sizeB);
+        m_needsFullRender = true;
+    }
+    else if (m_buffer->sizeB() != sizeB || m_rect != rect)
+    {
+        m_buffer->setSizeB(sizeB);
+        m_needsFullRender = true;
+    }
+
+    m_rect = rect;
+    m_buffer->setScale(m_scale);
+    m_buffer->setPos(m_rect.pos());
+
+    LRegion damage;
+
+    if (m_needsFullRender || m_entries.size() != m_prevEntries.size())
+        damage.addRect(m_rect);
+    else
+    {
+        for (size_t i = 0; i < m_entries.size(); i++)
+        {
+            const Entry &curr { m_entries[i] };
+            const Entry &prev { m_prevEntries[i] };
+
+            if (curr.surface != prev.surface)
+            {
+                damage.addRect(m_rect);
+                break;
+            }
+
+            if (curr.rect != prev.rect)
+            {
+                damage.addRect(prev.rect);
+                damage.addRect(curr.rect);
+            }
+            else if (curr.damageId != prev.damageId)
+            {
+                // Several commits may have happened since the last update, so the last damage is not enough
+                damage.addRect(curr.rect);
+            }
+        }
+    }
+
+    m_needsFullRender = false;
+
+    if (damage.empty())
+        return true;
+
+    m_translucentRegion.clear();
+    m_translucentRegion.addRect(m_rect);
+    LRegion opaque;
+
+    for (const Entry &e : m_entries)
+    {
+        LRegion surfaceOpaque { e.surface->opaqueRegion() };
+        surfaceOpaque.offset(e.rect.pos());
+        opaque.addRegion(surfaceOpaque);
+    }
+
+    m_translucentRegion.subtractRegion(opaque);
+    m_translucentRegion.offset(LPoint() - m_rect.pos());
+
+    LFramebuffer *prevFb { painter->boundFramebuffer() };
+    painter->bindFramebuffer(m_buffer);
+    painter->setAlpha(1.f);
+    painter->setColorFactor(1.f, 1.f, 1.f, 1.f);
+    painter->enableAutoBlendFunc(true);
+
+    // Clear the damaged area
+    glDisable(GL_BLEND);
+    painter->bindColorMode();
+    painter->setColor({0.f, 0.f, 0.f});
+    painter->setAlpha(0.f);
+    painter->drawRegion(damage);
+    painter->setAlpha(1.f);
+    glEnable(GL_BLEND);
+
+    LRegion region;
+
+    for (const Entry &e : m_entries)
+    {
+        region = damage;
+        region.clip(e.rect);
+
+        if (region.empty())
+            continue;
+
+        painter->bindTextureMode({
+            .texture = e.surface->texture(),
+            .pos = e.rect.pos(),
+            .srcRect = e.surface->srcRect(),
+            .dstSize = e.rect.size(),
+            .srcTransform = e.surface->bufferTransform(),
+            .srcScale = Float32(e.surface->bufferScale()),
+        });
+
+        painter->enableCustomTextureColor(false);
+        painter->drawRegion(region);
+    }
+
+    painter->bindFramebuffer(prevFb);
+    m_buffer->texture()->invalidateMipmaps();
+    return true;
+}
@@ -0,0 +1,136 @@
+#ifndef LSURFACECAPTURE_H
+#define LSURFACECAPTURE_H
+
+#include <LObject.h>
+#include <LRegion.h>
+#include <LWeak.h>
+#include <vector>
+
+/**
+ * @brief Offscreen capture of a surface and its subsurfaces
+ *
+ * Renders a surface together with its subsurface tree into a render target, which can then be
+ * displayed for example with an LTextureView, without having to create temporary LSceneViews or copy textures.\n
+ * Render targets are taken from a compositor-wide pool and returned to it when the capture is released or destroyed,
+ * so many captures (e.g. live thumbnails of a window switcher) can be created and refreshed frequently.
+ *
+ * Calling update() again only re-renders the areas of the surfaces that changed since the previous update.
+ *
+ * @note update() must be called from a thread with an LPainter, such as the main thread or during LOutput::paintGL().
+ */
+class Louvre::LSurfaceCapture final : public LObject
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param surface The surface to capture, can be `nullptr`.
+     * @param scale The scale factor of the captured image. For example, 0.5 renders it at half its size.
+     */
+    LSurfaceCapture(LSurface *surface = nullptr, Float32 scale = 1.f) noexcept;
+
+    LCLASS_NO_COPY(LSurfaceCapture)
+
+    /**
+     * @brief Destructor, returns the render target to the pool.
+     */
+    ~LSurfaceCapture() noexcept;
+
+    /**
+     * @brief Sets the surface to capture.
+     *
+     * The next update() renders it entirely.
+     */
+    void setSurface(LSurface *surface) noexcept;
+
+    /**
+     * @brief The captured surface or `nullptr` if destroyed or not set.
+     */
+    LSurface *surface() const noexcept
+    {
+        return m_surface.get();
+    }
+
+    /**
+     * @brief Sets the scale factor of the captured image.
+     *
+     * Values are clamped to a minimum of 0.1.
+     */
+    void setScale(Float32 scale) noexcept;
+
+    /**
+     * @brief Scale factor set with setScale().
+     */
+    Float32 scale() const noexcept
+    {
+        return m_scale;
+    }
+
+    /**
+     * @brief Renders the surface tree.
+     *
+     * Only the areas that changed since the last call are rendered again.
+     *
+     * @return `true` if texture() contains a valid capture, `false` if the surface is not mapped or there is no painter on the current thread.
+     */
+    bool update() noexcept;
+
+    /**
+     * @brief Captured texture.
+     *
+     * Its buffer scale is scale() and its content covers rect(). Returns `nullptr` if update()
+     * was never called successfully or the capture was released.
+     *
+     * @note The texture is owned by the pool and is only valid until release() or the capture is destroyed.
+     */
+    LTexture *texture() const noexcept;
+
+    /**
+     * @brief Area captured in surface coordinates.
+     *
+     * Relative to the root surface rolePos(), may have a negative position if subsurfaces extend beyond its top-left corner.
+     */
+    const LRect &rect() const noexcept
+    {
+        return m_rect;
+    }
+
+    /**
+     * @brief Translucent region of the captured content, relative to rect().
+     */
+    const LRegion &translucentRegion() const noexcept
+    {
+        return m_translucentRegion;
+    }
+
+    /**
+     * @brief Returns the render target to the pool.
+     *
+     * The next update() acquires a new one and renders everything again.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Destroys all the unused render targets of the pool.
+     */
+    static void clearPool() noexcept;
+
+private:
+    struct Entry
+    {
+        LSurface *surface;
+        UInt32 damageId;
+        LRect rect;
+    };
+
+    void collect(LSurface *root) noexcept;
+    LWeak<LSurface> m_surface;
+    LRenderBuffer *m_buffer { nullptr };
+    std::vector<Entry> m_entries, m_prevEntries;
+    LRegion m_translucentRegion;
+    LRect m_rect;
+    Float32 m_scale { 1.f };
+    bool m_needsFullRender { true };
+};
+
+#endif // LSURFACECAPTURE_H
@@ -318,7 +318,6 @@ LTexture *LTexture::copy(const LSize &dst, const LRect &src, bool highQualitySca
         LTexture::LTexturePrivate::setTextureParams(textureId, textureTarget, GL_REPEAT, GL_REPEAT, GL_LINEAR, GL_LINEAR);
         glUniform2f(painter->imp()->currentUniformsScaler->pixelSize, pixSizeW, pixSizeH);
         glUniform2i(painter->imp()->currentUniformsScaler->iters, wScale, hScale);
-        painter->imp()->shaderSetMode(LPainter::LPainterPrivate::LegacyMode);
         glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
         textureCopy = new LTexture(premultipliedAlpha());
         glFinish();
@@ -566,6 +565,7 @@ void LTexture::reset() noexcept
     }
 
     m_serial++;
+    m_mipmapStates.clear();
 
     if (sourceType() == Framebuffer)
     {
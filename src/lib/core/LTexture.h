@@ -320,6 +320,47 @@ namespace Louvre
             m_premultipliedAlpha = premultipledAlpha;
         }
 
+        /**
+         * @brief Enables or disables mipmapped sampling.
+         *
+         * When enabled, LPainter lazily generates a mipmap chain on the GPU the first time the texture
+         * is drawn smaller than its buffer size, and samples it with trilinear filtering instead of plain
+         * bilinear filtering. The chain is regenerated after the serial() changes or invalidateMipmaps() is called.
+         *
+         * Views can also request it for any texture they draw with LView::enableMipmapFiltering().
+         *
+         * @note Only textures owned by Louvre (`CPU` and `Framebuffer` source types) with the `GL_TEXTURE_2D` target are supported.
+         *       Imported buffers (`DMA`, `WL_DRM` and `Native`) are always sampled with bilinear filtering, since generating mipmaps
+         *       would detach them from their source buffer.
+         *
+         * Disabled by default.
+         */
+        void enableMipmaps(bool enabled) noexcept
+        {
+            m_mipmaps = enabled;
+        }
+
+        /**
+         * @brief Checks if mipmapped sampling is enabled.
+         *
+         * @see enableMipmaps()
+         */
+        bool mipmapsEnabled() const noexcept
+        {
+            return m_mipmaps;
+        }
+
+        /**
+         * @brief Marks the mipmap chain as outdated.
+         *
+         * Must be called after modifying the texture content without changing its serial(), for example
+         * when rendering into an LRenderBuffer. The chain is regenerated the next time it is sampled.
+         */
+        void invalidateMipmaps() noexcept
+        {
+            m_mipmapStates.clear();
+        }
+
         class LTexturePrivate;
 
     private:
@@ -329,7 +370,17 @@ namespace Louvre
         friend class LDMABuffer;
         friend class LSurface;
         friend class LOutput;
+        friend class LPainter;
+
+        // Mipmap chain generated for a specific texture ID
+        struct MipmapState
+        {
+            const LOutput *output;
+            GLuint id;
+            UInt32 serial;
+        };
 
+        std::vector<MipmapState> m_mipmapStates;
         void *m_graphicBackendData { nullptr };
         LSize m_sizeB;
         UInt32 m_format { 0 };
@@ -341,6 +392,7 @@ namespace Louvre
         LWeak<LOutput> m_nativeOutput;
         GLuint m_nativeId { 0 };
         bool m_pendingDelete { false };
+        bool m_mipmaps { false };
         mutable bool m_premultipliedAlpha;
 
         LWeak<LSurface> m_surface;
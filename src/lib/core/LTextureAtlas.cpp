@@ -0,0 +1,143 @@
+#include <LTextureAtlas.h>
+#include <LUtils.h>
+#include <LLog.h>
+
+using namespace Louvre;
+
+LTextureAtlas::LTextureAtlas(const LSize &pageSizeB, UInt32 format, Int32 padding) noexcept :
+    m_pageSizeB(pageSizeB),
+    m_format(format),
+    m_padding(padding < 0 ? 0 : padding)
+{}
+
+LTextureAtlas::~LTextureAtlas() noexcept
+{
+    notifyDestruction();
+    clear();
+}
+
+LTextureAtlas::Entry *LTextureAtlas::add(const LSize &sizeB, UInt32 stride, const void *buffer) noexcept
+{
+    if (!buffer || sizeB.w() <= 0 || sizeB.h() <= 0)
+        return nullptr;
+
+    const LSize paddedSizeB { sizeB.w() + m_padding, sizeB.h() + m_padding };
+
+    if (paddedSizeB.w() > m_pageSizeB.w() || paddedSizeB.h() > m_pageSizeB.h())
+    {
+        LLog::error("[LTextureAtlas::add] Image (%dx%d) larger than the page size (%dx%d).",
+                    sizeB.w(), sizeB.h(), m_pageSizeB.w(), m_pageSizeB.h());
+        return nullptr;
+    }
+
+    LPoint pos;
+    UInt32 pageIndex { 0 };
+
+    for (; pageIndex < m_pages.size(); pageIndex++)
+        if (allocate(m_pages[pageIndex], paddedSizeB, &pos))
+            break;
+
+    // Pages are fully transparent initially, which also clears the padding
+    const UInt32 pageStride { m_pageSizeB.w() * LTexture::formatBytesPerPixel(m_format) };
+
+    if (pageIndex == m_pages.size())
+    {
+        const std::vector<UInt8> pixels(pageStride * m_pageSizeB.h(), 0);
+        Page page;
+        page.texture = std::make_unique<LTexture>();
+
+        if (!page.texture->setDataFromMainMemory(m_pageSizeB, pageStride, m_format, pixels.data()))
+        {
+            LLog::error("[LTextureAtlas::add] Failed to create page texture.");
+            return nullptr;
+        }
+
+        m_pages.push_back(std::move(page));
+        allocate(m_pages.back(), paddedSizeB, &pos);
+    }
+
+    Page &page { m_pages[pageIndex] };
+
+    if (page.needsClear)
+    {
+        const std::vector<UInt8> pixels(pageStride * m_pageSizeB.h(), 0);
+        page.texture->updateRect(LRect(0, m_pageSizeB), pageStride, pixels.data());
+        page.needsClear = false;
+    }
+
+    const LRect rectB { pos, sizeB };
+
+    if (!page.texture->updateRect(rectB, stride, buffer))
+    {
+        LLog::error("[LTextureAtlas::add] Failed to copy image into page.");
+
+        if (page.entries == 0)
+            reset(page);
+
+        return nullptr;
+    }
+
+    return createEntry(pageIndex, rectB);
+}
+
+LTextureAtlas::Entry *LTextureAtlas::createEntry(UInt32 pageIndex, const LRect &rectB) noexcept
+{
+    Page &page { m_pages[pageIndex] };
+    page.entries++;
+    m_entries.push_back(new Entry(pageIndex, page.texture.get(), rectB));
+    return m_entries.back();
+}
+
+void LTextureAtlas::remove(Entry *entry) noexcept
+{
+    if (!entry || std::find(m_entries.begin(), m_entries.end(), entry) == m_entries.end())
+        return;
+
+    LVectorRemoveOneUnordered(m_entries, entry);
+
+    Page &page { m_pages[entry->m_page] };
+    page.entries--;
+
+    if (page.entries == 0)
+        reset(page);
+
+    delete entry;
+}
+
+void LTextureAtlas::clear() noexcept
+{
+    while (!m_entries.empty())
+        remove(m_entries.back());
+}
+
+void LTextureAtlas::reset(Page &page) noexcept
+{
+    page.shelves.clear();
+    page.bottom = 0;
+    page.needsClear = true;
+}
+
+bool LTextureAtlas::allocate(Page &page, const LSize &sizeB, LPoint *pos) noexcept
+{
+    Shelf *best { nullptr };
+
+    // Lowest shelf where the image fits, to waste as little height as possible
+    for (Shelf &shelf : page.shelves)
+        if (shelf.h >= sizeB.h() && m_pageSizeB.w() - shelf.x >= sizeB.w() && (!best || shelf.h < best->h))
+            best = &shelf;
+
+    if (!best)
+    {
+        if (m_pageSizeB.h() - page.bottom < sizeB.h())
+            return false;
+
+        page.shelves.push_back({ .y = page.bottom, .h = sizeB.h() });
+        page.bottom += sizeB.h();
+        best = &page.shelves.back();
+    }
+
+    pos->setX(best->x);
+    pos->setY(best->y);
+    best->x += sizeB.w();
+    return true;
+}
@@ -0,0 +1,167 @@
+#ifndef LTEXTUREATLAS_H
+#define LTEXTUREATLAS_H
+
+#include <LTexture.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Packs small textures into shared pages
+ *
+ * Drawing many small textures (icons, buttons, labels, decorations, etc) requires binding a different texture for each one.
+ * An LTextureAtlas instead copies them into a few large LTexture pages, each added image being represented by an Entry,
+ * which is just a page and the rect it occupies within it.\n
+ * Since LPainter::bindTextureMode() and LTextureView already support source rects, entries can be displayed without extra work,
+ * see LTextureView::setAtlasEntry().
+ *
+ * Entries are packed into horizontal shelves and separated by transparent padding to prevent neighbouring entries from
+ * bleeding when scaled. The space of removed entries is reclaimed once all the entries of a page are removed, so the atlas
+ * is best suited for immutable content that lives for a long time.
+ *
+ * @note Images larger than the page size can't be added, use a regular LTexture for them instead.
+ */
+class Louvre::LTextureAtlas : public LObject
+{
+public:
+    /**
+     * @brief Image stored in an LTextureAtlas
+     *
+     * Entries are owned by the atlas, and are destroyed with LTextureAtlas::remove() or when the atlas is destroyed.
+     */
+    class Entry : public LObject
+    {
+    public:
+        LCLASS_NO_COPY(Entry)
+
+        /**
+         * @brief Atlas page containing the image.
+         *
+         * Shared with other entries and owned by the atlas.
+         */
+        LTexture *texture() const noexcept
+        {
+            return m_texture;
+        }
+
+        /**
+         * @brief Rect occupied by the image within the texture() in buffer coordinates.
+         */
+        const LRect &rectB() const noexcept
+        {
+            return m_rectB;
+        }
+
+    private:
+        friend class LTextureAtlas;
+        Entry(UInt32 page, LTexture *texture, const LRect &rectB) noexcept :
+            m_page(page), m_texture(texture), m_rectB(rectB) {}
+        ~Entry() noexcept = default;
+        UInt32 m_page;
+        LTexture *m_texture;
+        LRect m_rectB;
+    };
+
+    /**
+     * @brief Constructs an empty atlas.
+     *
+     * Pages are created as entries are added.
+     *
+     * @param pageSizeB Size of each page in buffer coordinates.
+     * @param format DRM format of the pages and the images added to them.
+     * @param padding Transparent pixels left between entries.
+     */
+    LTextureAtlas(const LSize &pageSizeB = LSize(1024, 1024), UInt32 format = DRM_FORMAT_ARGB8888, Int32 padding = 1) noexcept;
+
+    LCLASS_NO_COPY(LTextureAtlas)
+
+    /**
+     * @brief Destroys the atlas, its pages and all its entries.
+     */
+    ~LTextureAtlas() noexcept;
+
+    /**
+     * @brief Copies an image into the atlas.
+     *
+     * @param sizeB Size of the image in buffer coordinates.
+     * @param stride The stride of the source buffer.
+     * @param buffer Pixels of the image, in the format() of the atlas.
+     * @return The new entry or `nullptr` if the image doesn't fit in a page or the page texture couldn't be created or updated.
+     */
+    Entry *add(const LSize &sizeB, UInt32 stride, const void *buffer) noexcept;
+
+    /**
+     * @brief Destroys an entry.
+     *
+     * Its space is reused once all the entries of its page are removed.
+     */
+    void remove(Entry *entry) noexcept;
+
+    /**
+     * @brief Removes all entries.
+     *
+     * The pages are kept and their space reused by the following entries.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Number of entries.
+     */
+    UInt32 entriesCount() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Number of pages, each one is a single texture.
+     */
+    UInt32 pagesCount() const noexcept
+    {
+        return m_pages.size();
+    }
+
+    /**
+     * @brief Size of the pages in buffer coordinates.
+     */
+    const LSize &pageSizeB() const noexcept
+    {
+        return m_pageSizeB;
+    }
+
+    /**
+     * @brief DRM format of the pages.
+     */
+    UInt32 format() const noexcept
+    {
+        return m_format;
+    }
+
+private:
+    struct Shelf
+    {
+        Int32 y, h;
+        Int32 x { 0 };
+    };
+
+    struct Page
+    {
+        std::unique_ptr<LTexture> texture;
+        std::vector<Shelf> shelves;
+        Int32 bottom { 0 };
+        UInt32 entries { 0 };
+
+        // Set when emptied, the pixels of removed entries must be cleared to keep the padding transparent
+        bool needsClear { false };
+    };
+
+    friend class LTextureAtlasTest;
+    bool allocate(Page &page, const LSize &sizeB, LPoint *pos) noexcept;
+    Entry *createEntry(UInt32 pageIndex, const LRect &rectB) noexcept;
+    void reset(Page &page) noexcept;
+    std::vector<Page> m_pages;
+    std::vector<Entry*> m_entries;
+    LSize m_pageSizeB;
+    UInt32 m_format;
+    Int32 m_padding;
+};
+
+#endif // LTEXTUREATLAS_H
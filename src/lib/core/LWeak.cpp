@@ -3,7 +3,7 @@
 
 using namespace Louvre;
 
-std::vector<void *> &LWeakUtils::objectRefs(const LObject *object) noexcept
+LObject::WeakRefs &LWeakUtils::objectRefs(const LObject *object) noexcept
 {
     return object->m_weakRefs;
 }
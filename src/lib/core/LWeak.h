@@ -1,13 +1,13 @@
 #ifndef LWEAK_H
 #define LWEAK_H
 
-#include <LNamespaces.h>
+#include <LObject.h>
 #include <functional>
 
 class Louvre::LWeakUtils
 {
 public:
-    static std::vector<void *> &objectRefs(const LObject *object) noexcept;
+    static LObject::WeakRefs &objectRefs(const LObject *object) noexcept;
     static bool isObjectDestroyed(const LObject *object) noexcept;
 };
 
@@ -124,8 +124,7 @@ public:
     {
         if (m_object)
         {
-            const auto &refs = (std::vector<LWeak<T>*>&)LWeakUtils::objectRefs((const LObject*)m_object);
-            return refs.size();
+            return LWeakUtils::objectRefs((const LObject*)m_object).size();
         }
 
         return 0;
@@ -180,9 +179,10 @@ private:
     {
         if (m_object)
         {
-            auto &refs = (std::vector<LWeak<T>*>&)LWeakUtils::objectRefs((const LObject*)m_object);
-            refs.back()->m_index = m_index;
-            refs[m_index] = refs.back();
+            auto &refs = LWeakUtils::objectRefs((const LObject*)m_object);
+            LWeak<T> *last { static_cast<LWeak<T>*>(refs.back()) };
+            last->m_index = m_index;
+            refs[m_index] = last;
             refs.pop_back();
             m_object = nullptr;
         }
@@ -194,7 +194,7 @@ private:
             return;
 
         m_object = object;
-        auto &refs = (std::vector<LWeak<T>*>&)LWeakUtils::objectRefs((const LObject*)m_object);
+        auto &refs = LWeakUtils::objectRefs((const LObject*)m_object);
         refs.push_back(this);
         m_index = refs.size() - 1;
     }
@@ -58,6 +58,7 @@ void LKeyboardKeyEvent::notify()
 
     if (compositor()->state() == LCompositor::Initialized)
     {
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
         seat()->keyboard()->keyEvent(*this);
     }
@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <private/LPointerPrivate.h>
 #include <LPointerButtonEvent.h>
 #include <LCompositor.h>
@@ -10,6 +11,7 @@ void LPointerButtonEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
 
         if (state() == Pressed)
@@ -17,6 +19,7 @@ void LPointerButtonEvent::notify()
         else
             LVectorRemoveOneUnordered(seat()->pointer()->imp()->pressedButtons, button());
 
+        seat()->imp()->tracePointerLatency(*this);
         seat()->pointer()->pointerButtonEvent(*this);
     }
 }
@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <LPointerHoldBeginEvent.h>
 #include <LCompositor.h>
 #include <LSeat.h>
@@ -9,6 +10,7 @@ void LPointerHoldBeginEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
         seat()->pointer()->pointerHoldBeginEvent(*this);
     }
@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <LPointerHoldEndEvent.h>
 #include <LCompositor.h>
 #include <LSeat.h>
@@ -9,6 +10,7 @@ void LPointerHoldEndEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
         seat()->pointer()->pointerHoldEndEvent(*this);
     }
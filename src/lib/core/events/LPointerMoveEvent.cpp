@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <LPointerMoveEvent.h>
 #include <LCompositor.h>
 #include <LSeat.h>
@@ -9,7 +10,12 @@ void LPointerMoveEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        if (seat()->imp()->coalescePointerMoveEvent(*this))
+            return;
+
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
+        seat()->imp()->tracePointerLatency(*this);
         seat()->pointer()->pointerMoveEvent(*this);
     }
 }
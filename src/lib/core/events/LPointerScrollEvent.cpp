@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <LPointerScrollEvent.h>
 #include <LCompositor.h>
 #include <LPointer.h>
@@ -9,7 +10,12 @@ void LPointerScrollEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        if (seat()->imp()->coalescePointerScrollEvent(*this))
+            return;
+
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
+        seat()->imp()->tracePointerLatency(*this);
         seat()->pointer()->pointerScrollEvent(*this);
     }
 }
@@ -1,3 +1,4 @@
+#include <private/LSeatPrivate.h>
 #include <LPointerSwipeEndEvent.h>
 #include <LCompositor.h>
 #include <LSeat.h>
@@ -9,6 +10,7 @@ void LPointerSwipeEndEvent::notify()
 {
     if (compositor()->state() == LCompositor::Initialized)
     {
+        seat()->imp()->flushPendingPointerEvents();
         seat()->onEvent(*this);
         seat()->pointer()->pointerSwipeEndEvent(*this);
     }
@@ -0,0 +1,212 @@
+#include <private/LAsyncTextureLoader.h>
+#include <private/LCompositorPrivate.h>
+#include <private/LTexturePrivate.h>
+#include <other/stb_image.h>
+#include <LCompositor.h>
+#include <LTexture.h>
+#include <LOpenGL.h>
+#include <LUtils.h>
+#include <LLog.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+
+using namespace Louvre;
+
+LAsyncTextureLoader::LAsyncTextureLoader() noexcept
+{
+    m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_eventFd == -1)
+    {
+        LLog::error("[LAsyncTextureLoader::LAsyncTextureLoader] Failed to create eventfd.");
+        return;
+    }
+
+    m_eventSource = LCompositor::addFdListener(m_eventFd, this, &LAsyncTextureLoader::onDecoded);
+
+    // Decoding is mostly memory bound, a few threads are enough
+    const UInt32 threads { std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u) };
+
+    for (UInt32 i = 0; i < threads; i++)
+        m_workers.emplace_back(&LAsyncTextureLoader::workerLoop, this);
+}
+
+LAsyncTextureLoader::~LAsyncTextureLoader() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_finished = true;
+    }
+
+    m_cond.notify_all();
+
+    for (auto &worker : m_workers)
+        worker.join();
+
+    for (auto &req : m_decoded)
+        stbi_image_free(req.pixels);
+
+    if (m_eventSource)
+        LCompositor::removeFdListener(m_eventSource);
+
+    if (m_eventFd != -1)
+        close(m_eventFd);
+}
+
+UInt32 LAsyncTextureLoader::load(const std::filesystem::path &file, const std::function<void(LTexture*)> &callback) noexcept
+{
+    if (m_workers.empty())
+    {
+        // Fallback if the loader could not be initialized
+        callback(LOpenGL::loadTexture(file));
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+
+    // 0 is reserved for failures
+    if (++m_lastId == 0)
+        m_lastId = 1;
+
+    m_pending.push_back({ .id = m_lastId, .file = file, .callback = callback });
+    m_cond.notify_one();
+    return m_lastId;
+}
+
+void LAsyncTextureLoader::cancel(UInt32 id) noexcept
+{
+    std::lock_guard<std::mutex> lock { m_mutex };
+
+    for (auto it = m_pending.begin(); it != m_pending.end(); it++)
+    {
+        if (it->id == id)
+        {
+            m_pending.erase(it);
+            return;
+        }
+    }
+
+    for (auto it = m_decoded.begin(); it != m_decoded.end(); it++)
+    {
+        if (it->id == id)
+        {
+            stbi_image_free(it->pixels);
+            m_decoded.erase(it);
+            return;
+        }
+    }
+
+    // Being decoded right now
+    if (std::find(m_decoding.begin(), m_decoding.end(), id) != m_decoding.end())
+        m_canceled.push_back(id);
+}
+
+LTexture *LAsyncTextureLoader::createTexture(const LSize &size, UInt8 *pixels) noexcept
+{
+    LTexture *texture { new LTexture() };
+
+    if (!texture->setDataFromMainMemory(size, size.w() * 4, DRM_FORMAT_ABGR8888, pixels))
+    {
+        LTexture::LTexturePrivate::swapRedBlue(pixels, size.area());
+        texture->setDataFromMainMemory(size, size.w() * 4, DRM_FORMAT_ARGB8888, pixels);
+    }
+
+    return texture;
+}
+
+void LAsyncTextureLoader::workerLoop() noexcept
+{
+    std::unique_lock<std::mutex> lock { m_mutex };
+
+    while (true)
+    {
+        m_cond.wait(lock, [this]{ return m_finished || !m_pending.empty(); });
+
+        if (m_finished)
+            return;
+
+        Request req { std::move(m_pending.front()) };
+        m_pending.pop_front();
+        m_decoding.push_back(req.id);
+        lock.unlock();
+
+        Int32 width, height, channels;
+        req.pixels = stbi_load(req.file.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+        if (req.pixels)
+            req.size = LSize(width, height);
+        else
+            LLog::error("[LAsyncTextureLoader::workerLoop] Failed to load image %s: %s.", req.file.c_str(), stbi_failure_reason());
+
+        lock.lock();
+        LVectorRemoveOneUnordered(m_decoding, req.id);
+
+        auto canceled { std::find(m_canceled.begin(), m_canceled.end(), req.id) };
+
+        if (canceled != m_canceled.end())
+        {
+            m_canceled.erase(canceled);
+            stbi_image_free(req.pixels);
+            continue;
+        }
+
+        m_decoded.push_back(std::move(req));
+
+        static const UInt64 one { 1 };
+        [[maybe_unused]] const ssize_t ret { write(m_eventFd, &one, sizeof(one)) };
+    }
+}
+
+int LAsyncTextureLoader::onDecoded(int fd, unsigned int mask, void *data) noexcept
+{
+    L_UNUSED(mask)
+    UInt64 value;
+    [[maybe_unused]] const ssize_t ret { read(fd, &value, sizeof(value)) };
+    static_cast<LAsyncTextureLoader*>(data)->processDecoded();
+    return 0;
+}
+
+void LAsyncTextureLoader::processDecoded() noexcept
+{
+    const UInt64 budget { compositor()->imp()->asyncTextureUploadBudget };
+    UInt64 uploaded { 0 };
+
+    // Upload at least one texture per iteration (even with a zero budget), then stop once the budget is exceeded
+    do
+    {
+        Request req;
+
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+
+            if (m_decoded.empty())
+                return;
+
+            req = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        LTexture *texture { nullptr };
+
+        if (req.pixels)
+        {
+            texture = createTexture(req.size, req.pixels);
+            stbi_image_free(req.pixels);
+            uploaded += UInt64(req.size.area()) * 4;
+        }
+
+        // May cancel or queue other requests
+        req.callback(texture);
+    }
+    while (uploaded < budget);
+
+    std::lock_guard<std::mutex> lock { m_mutex };
+
+    // Continue in the next main loop iteration
+    if (!m_decoded.empty())
+    {
+        static const UInt64 one { 1 };
+        [[maybe_unused]] const ssize_t ret { write(m_eventFd, &one, sizeof(one)) };
+    }
+}
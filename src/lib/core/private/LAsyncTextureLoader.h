@@ -0,0 +1,59 @@
+#ifndef LASYNCTEXTURELOADER_H
+#define LASYNCTEXTURELOADER_H
+
+#include <LNamespaces.h>
+#include <LSize.h>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+struct wl_event_source;
+
+namespace Louvre
+{
+    /* Decodes image files on a pool of worker threads and creates the textures
+     * on the main thread, see LOpenGL::loadTextureAsync() */
+    class LAsyncTextureLoader
+    {
+    public:
+        LAsyncTextureLoader() noexcept;
+        ~LAsyncTextureLoader() noexcept;
+
+        UInt32 load(const std::filesystem::path &file, const std::function<void(LTexture*)> &callback) noexcept;
+        void cancel(UInt32 id) noexcept;
+
+        // Creates the texture from RGBA pixels on the calling thread
+        static LTexture *createTexture(const LSize &size, UInt8 *pixels) noexcept;
+
+    private:
+        struct Request
+        {
+            UInt32 id;
+            std::filesystem::path file;
+            std::function<void(LTexture*)> callback;
+            UInt8 *pixels { nullptr };
+            LSize size;
+        };
+
+        void workerLoop() noexcept;
+        void processDecoded() noexcept;
+        static int onDecoded(int fd, unsigned int mask, void *data) noexcept;
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::deque<Request> m_pending;
+        std::deque<Request> m_decoded;
+        std::vector<UInt32> m_decoding;
+        std::vector<UInt32> m_canceled;
+        wl_event_source *m_eventSource { nullptr };
+        UInt32 m_lastId { 0 };
+        Int32 m_eventFd { -1 };
+        bool m_finished { false };
+    };
+}
+
+#endif // LASYNCTEXTURELOADER_H
@@ -1,4 +1,6 @@
 #include <private/LCompositorPrivate.h>
+#include <protocols/Wayland/RSurface.h>
+#include <LSurfaceCapture.h>
 #include <private/LClientPrivate.h>
 #include <private/LSeatPrivate.h>
 #include <private/LSurfacePrivate.h>
@@ -8,6 +10,7 @@
 #include <private/LToplevelRolePrivate.h>
 #include <private/LPopupRolePrivate.h>
 #include <private/LFactory.h>
+#include <private/LOrderChangeFilter.h>
 #include <LActivationTokenManager.h>
 #include <LSessionLockManager.h>
 #include <LSessionLockRole.h>
@@ -25,6 +28,7 @@
 #include <dlfcn.h>
 #include <string.h>
 #include <cassert>
+#include <algorithm>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -33,10 +37,17 @@
 
 void LCompositor::LCompositorPrivate::processRemovedGlobals()
 {
+    if (!hasRemovedGlobals)
+        return;
+
+    hasRemovedGlobals = false;
+
     for (auto it = globals.begin(); it != globals.end();)
     {
         if ((*it)->m_removed)
         {
+            hasRemovedGlobals = true;
+
             if ((*it)->m_destroyRoundtrips == 3)
             {
                 delete *it;
@@ -229,6 +240,9 @@ void LCompositor::LCompositorPrivate::unitWayland()
 void LCompositor::LCompositorPrivate::unitCompositor()
 {
     state = CompositorState::Uninitializing;
+    asyncTextureLoader.reset();
+    hiddenSurfacesFrameTimer.reset();
+    LSurfaceCapture::clearPool();
     unitInputBackend(true);
     unitGraphicBackend(true);
     unitSeat();
@@ -342,6 +356,7 @@ bool LCompositor::LCompositorPrivate::initGraphicBackend()
     char const *eglExts = eglQueryString(mainEGLDisplay, EGL_EXTENSIONS);
 
     WL_bind_wayland_display = LOpenGL::hasExtension(eglExts, "EGL_WL_bind_wayland_display");
+    KHR_fence_sync = LOpenGL::hasExtension(eglExts, "EGL_KHR_fence_sync") && eglCreateSyncKHR && eglClientWaitSyncKHR && eglDestroySyncKHR;
 
     if (WL_bind_wayland_display)
         eglBindWaylandDisplayWL(eglDisplay(), display);
@@ -625,18 +640,119 @@ bool LCompositor::LCompositorPrivate::loadInputBackend(const std::filesystem::pa
     return true;
 }
 
-void LCompositor::LCompositorPrivate::notifyOrderChangeFromSurface(LSurface *from)
+void LCompositor::LCompositorPrivate::queueOrderChange(LSurface *surface, bool force) noexcept
+{
+    if (!surface)
+        return;
+
+    if (force)
+        surface->imp()->stateFlags.add(LSurface::LSurfacePrivate::OrderChangeForced);
+
+    if (surface->imp()->stateFlags.check(LSurface::LSurfacePrivate::OrderChangePending))
+        return;
+
+    // Changes queued outside a dispatch (e.g. from orderChanged() itself) must wake up the loop
+    if (pendingOrderChanges.empty())
+        unlockPoll();
+
+    surface->imp()->stateFlags.add(LSurface::LSurfacePrivate::OrderChangePending);
+    pendingOrderChanges.emplace_back(surface);
+}
+
+void LCompositor::LCompositorPrivate::notifyOrderChanges() noexcept
+{
+    if (pendingOrderChanges.empty())
+        return;
+
+    std::vector<LWeak<LSurface>> changes;
+    changes.swap(pendingOrderChanges);
+
+    std::erase_if(changes, [](const LWeak<LSurface> &surface) { return surface.get() == nullptr; });
+
+    // From bottom to top, as surfaces reacting to it usually restack relative to their previous surface
+    std::sort(changes.begin(), changes.end(), [](const LWeak<LSurface> &a, const LWeak<LSurface> &b)
+    {
+        return a->imp()->orderKey < b->imp()->orderKey;
+    });
+
+    LOrderChangeFilter<LSurface> filter;
+    surfaceRaiseAllowedCounter++;
+
+    for (const LWeak<LSurface> &surface : changes)
+    {
+        // Destroyed by a previous handler
+        if (!surface)
+            continue;
+
+        auto &imp { *surface->imp() };
+        const bool forced { imp.stateFlags.check(LSurface::LSurfacePrivate::OrderChangeForced) };
+        imp.stateFlags.remove(LSurface::LSurfacePrivate::OrderChangePending | LSurface::LSurfacePrivate::OrderChangeForced);
+
+        LSurface *prev { surface->prevSurface() };
+
+        if (!filter.shouldNotify(surface.get(), prev, imp.notifiedPrevSurface.get(), forced))
+            continue;
+
+        imp.notifiedPrevSurface.reset(prev);
+        surface->orderChanged();
+    }
+
+    surfaceRaiseAllowedCounter--;
+}
+
+void LCompositor::LCompositorPrivate::queueExclusiveZonesNotify(LOutput *output) noexcept
+{
+    if (output->imp()->stateFlags.check(LOutput::LOutputPrivate::ExclusiveZonesNotifyPending))
+        return;
+
+    if (pendingExclusiveZonesNotify.empty())
+        unlockPoll();
+
+    output->imp()->stateFlags.add(LOutput::LOutputPrivate::ExclusiveZonesNotifyPending);
+    pendingExclusiveZonesNotify.emplace_back(output);
+}
+
+void LCompositor::LCompositorPrivate::notifyExclusiveZones() noexcept
 {
-    compositor()->imp()->surfaceRaiseAllowedCounter++;
+    // Handlers may change zones again, those changes are notified in the next iteration
+    std::vector<LWeak<LOutput>> outputs;
+    outputs.swap(pendingExclusiveZonesNotify);
+
+    for (const LWeak<LOutput> &output : outputs)
+        if (output)
+            output->imp()->notifyExclusiveZones();
+}
+
+// Distance between keys after relabeling, leaves room for ~4 billion surfaces and insertions
+static constexpr UInt64 orderKeyGap { UInt64(1) << 32 };
 
-    if (from)
-        for (auto it = from->imp()->compositorLink; it != surfaces.end(); it++)
-            (*it)->orderChanged();
+void LCompositor::LCompositorPrivate::updateOrderKey(LSurface *surface) noexcept
+{
+    const LSurface *prev { surface->prevSurface() };
+    const LSurface *next { surface->nextSurface() };
+    const UInt64 low { prev ? prev->imp()->orderKey : 0 };
+    const UInt64 high { next ? next->imp()->orderKey : UINT64_MAX };
+
+    // Raising to the top or lowering to the bottom is the common case, keep a regular gap there
+    if (!next && UINT64_MAX - low > orderKeyGap)
+        surface->imp()->orderKey = low + orderKeyGap;
+    else if (!prev && high > orderKeyGap)
+        surface->imp()->orderKey = high - orderKeyGap;
+    else if (high - low > 1)
+        surface->imp()->orderKey = low + (high - low) / 2;
     else
-        for (LSurface *surface : surfaces)
-            surface->orderChanged();
+        relabelSurfaces();
+}
+
+void LCompositor::LCompositorPrivate::relabelSurfaces() noexcept
+{
+    UInt64 key { 0 };
 
-    compositor()->imp()->surfaceRaiseAllowedCounter--;
+    for (LSurface *surface : surfaces)
+    {
+        key += orderKeyGap;
+        surface->imp()->orderKey = key;
+    }
 }
 
 
@@ -669,6 +785,9 @@ void LCompositor::LCompositorPrivate::insertSurfaceAfter(LSurface *prevSurface,
 
     if (options.check(UpdateSurfaces) && surfaceToInsert->prevSurface() != prevSurface)
     {
+        // The previous surface of the surface after it changes
+        queueOrderChange(surfaceToInsert->nextSurface());
+
         if (prevSurface)
         {
             surfaces.erase(surfaceToInsert->imp()->compositorLink);
@@ -689,7 +808,9 @@ void LCompositor::LCompositorPrivate::insertSurfaceAfter(LSurface *prevSurface,
             surfacesListChanged = true;
         }
 
-        notifyOrderChangeFromSurface(prevSurface);
+        updateOrderKey(surfaceToInsert);
+        queueOrderChange(surfaceToInsert);
+        queueOrderChange(surfaceToInsert->nextSurface());
     }
 
 #if LOUVRE_ASSERT_CHECKS == 1
@@ -709,10 +830,13 @@ void LCompositor::LCompositorPrivate::insertSurfaceBefore(LSurface *nextSurface,
 
     if (options.check(UpdateSurfaces) && surfaceToInsert->nextSurface() != nextSurface)
     {
+        queueOrderChange(surfaceToInsert->nextSurface());
         surfaces.erase(surfaceToInsert->imp()->compositorLink);
         surfaceToInsert->imp()->compositorLink = surfaces.insert(nextSurface->imp()->compositorLink, surfaceToInsert);
         surfacesListChanged = true;
-        notifyOrderChangeFromSurface(surfaceToInsert);
+        updateOrderKey(surfaceToInsert);
+        queueOrderChange(surfaceToInsert);
+        queueOrderChange(nextSurface);
     }
 
 #if LOUVRE_ASSERT_CHECKS == 1
@@ -828,6 +952,17 @@ void LCompositor::LCompositorPrivate::unlockPoll()
     L_UNUSED(n);
 }
 
+void LCompositor::LCompositorPrivate::requestPointerEventsFlush() noexcept
+{
+    if (!seat || !seat->imp()->hasPendingPointerEvents || pendingPointerEventsFlush.exchange(true))
+        return;
+
+    // Called without the lock, so pollUnlocked can't be used as in unlockPoll()
+    uint64_t eventValue = 1;
+    ssize_t n = write(events[LEV_UNLOCK].data.fd, &eventValue, sizeof(eventValue));
+    L_UNUSED(n);
+}
+
 LPainter *LCompositor::LCompositorPrivate::findPainter()
 {
     LPainter *painter = nullptr;
@@ -863,14 +998,95 @@ void LCompositor::LCompositorPrivate::sendPendingConfigurations()
     }
 }
 
+void LCompositor::LCompositorPrivate::scheduleHiddenSurfacesFrames() noexcept
+{
+    if (hiddenSurfacesFrameRate == 0 || (hiddenSurfacesFrameTimer && hiddenSurfacesFrameTimer->running()))
+        return;
+
+    if (!hiddenSurfacesFrameTimer)
+        hiddenSurfacesFrameTimer = std::make_unique<LTimer>([this](LTimer *) { sendHiddenSurfacesFrames(); });
+
+    hiddenSurfacesFrameTimer->start(1000 / hiddenSurfacesFrameRate);
+}
+
+void LCompositor::LCompositorPrivate::sendHiddenSurfacesFrames() noexcept
+{
+    if (hiddenSurfacesFrameRate == 0)
+        return;
+
+    const UInt32 period { 1000 / hiddenSurfacesFrameRate };
+    const UInt32 now { LTime::ms() };
+    UInt32 nextTimeout { period + 1 };
+
+    for (LSurface *s : surfaces)
+    {
+        auto &imp { *s->imp() };
+
+        if (!imp.hasCommittedFrameCallbacks())
+            continue;
+
+        // Displayed surfaces have their callbacks released after each repaint well before this
+        const UInt32 elapsed { now - imp.lastFrameCallbackMs };
+
+        if (elapsed >= period)
+            imp.sendHiddenFrame();
+        else
+            nextTimeout = std::min(nextTimeout, period - elapsed);
+    }
+
+    // Keep running only while there are committed callbacks
+    if (nextTimeout <= period)
+        hiddenSurfacesFrameTimer->start(std::max(nextTimeout, 1u));
+}
+
+// Surfaces of the same subsurface tree, where commits of synced children are applied together with their parent's
+static LSurface *subsurfaceTreeRoot(LSurface *surface) noexcept
+{
+    while (surface->subsurface() && surface->parent())
+        surface = surface->parent();
+
+    return surface;
+}
+
+void LCompositor::LCompositorPrivate::onDeferredCommitsLog(void */*data*/, wl_protocol_logger_type type, const wl_protocol_logger_message *message)
+{
+    if (type != WL_PROTOCOL_LOGGER_REQUEST)
+        return;
+
+    auto &imp { *compositor()->imp() };
+    const wl_client *client { wl_resource_get_client(message->resource) };
+    LSurface *requestTree { nullptr };
+
+    if (strcmp(wl_resource_get_class(message->resource), "wl_surface") == 0)
+        requestTree = subsurfaceTreeRoot(static_cast<Protocols::Wayland::RSurface*>(wl_resource_get_user_data(message->resource))->surface());
+
+    /* Requests to surfaces of other subsurface trees don't depend on the waiting commits, anything else must see them applied.
+     * Including other surfaces of the same tree: e.g. if a parent commit waits for its fence and a synced child commits, the
+     * child state must be cached after the parent commit is applied, otherwise it would be applied along with it */
+    retry:
+    for (LSurface *s : imp.deferredCommitSurfaces)
+    {
+        if (s->client()->client() != client || (requestTree && subsurfaceTreeRoot(s) != requestTree))
+            continue;
+
+        s->imp()->applyDeferredCommit();
+        goto retry;
+    }
+}
+
 void LCompositor::LCompositorPrivate::sendPresentationTime()
 {
     for (LOutput *o : outputs)
     {
         o->imp()->pageflipMutex.lock();
         if (o->imp()->stateFlags.check(LOutput::LOutputPrivate::HasUnhandledPresentationTime))
+        {
             for (LSurface *s : surfaces)
                 s->imp()->sendPresentationFeedback(o);
+
+            if (seat->imp()->pointerLatencyTracing)
+                seat->imp()->tracePointerLatencyPageFlip(o);
+        }
         o->imp()->pageflipMutex.unlock();
     }
 }
@@ -943,6 +1159,7 @@ retryName:
 
     wl_array_init(&dmaFeedback.formatIndices);
     wl_array_init(&dmaFeedback.scanoutIndices);
+    wl_array_init(&dmaFeedback.allIndices);
     dmaFeedback.device = graphicBackend->backendGetAllocatorDeviceId();
 
     ptr = map;
@@ -968,6 +1185,8 @@ retryName:
         if (!isScanout)
             *(UInt16*)wl_array_add(&dmaFeedback.formatIndices, sizeof(UInt16)) = formatIndex;
 
+        *(UInt16*)wl_array_add(&dmaFeedback.allIndices, sizeof(UInt16)) = formatIndex;
+
         formatIndex++;
     }
 
@@ -989,6 +1208,7 @@ void LCompositor::LCompositorPrivate::unitDMAFeedback() noexcept
         dmaFeedback.tableFd = -1;
         wl_array_release(&dmaFeedback.formatIndices);
         wl_array_release(&dmaFeedback.scanoutIndices);
+        wl_array_release(&dmaFeedback.allIndices);
     }
 }
 
@@ -1011,6 +1231,7 @@ void LCompositor::LCompositorPrivate::assertSurfacesOrder()
         for (LSurface *ls : layers[i])
         {
             assert(ls == surf);
+            assert(!surf->prevSurface() || surf->prevSurface()->imp()->orderKey < surf->imp()->orderKey);
             surf = surf->nextSurface();
         }
     }
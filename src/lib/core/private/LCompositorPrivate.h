@@ -2,10 +2,12 @@
 #define LCOMPOSITORPRIVATE_H
 
 #include <private/LBackendPrivate.h>
+#include <private/LAsyncTextureLoader.h>
 #include <LCompositor.h>
 #include <LOutput.h>
 #include <LInputDevice.h>
 #include <LRenderBuffer.h>
+#include <LTimer.h>
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 #include <sys/epoll.h>
@@ -14,6 +16,8 @@
 #include <string>
 #include <filesystem>
 #include <set>
+#include <atomic>
+#include <memory>
 
 using namespace Louvre;
 
@@ -28,6 +32,7 @@ LPRIVATE_CLASS(LCompositor)
     std::string defaultInputBackendName;
 
     std::vector<LGlobal*> globals;
+    bool hasRemovedGlobals { false };
     void processRemovedGlobals();
     void unitCompositor();
 
@@ -41,7 +46,8 @@ LPRIVATE_CLASS(LCompositor)
 #define LEV_LIBSEAT 1
 #define LEV_AUX 2
 #define LEV_WAYLAND 3
-        epoll_event events[4]; // [0] Unlock [1] Libseat [2] Aux [3] Wayland
+#define LEV_COUNT 4
+        epoll_event events[LEV_COUNT]; // [0] Unlock [1] Libseat [2] Aux [3] Wayland
         LSessionLockManager *sessionLockManager { nullptr };
         LActivationTokenManager *activationTokenManager { nullptr };
     void unitWayland();
@@ -49,6 +55,14 @@ LPRIVATE_CLASS(LCompositor)
     bool surfacesListChanged { false };
     bool animationsVectorChanged { false };
     bool pollUnlocked { false };
+    LCompositor::LoopCounters loopCounters;
+
+    // Set by rendering threads after a page flip
+    std::atomic<bool> hasUnhandledPresentationTime { false };
+
+    // Set by rendering threads to deliver coalesced pointer events, see LSeat::enablePointerEventCoalescing()
+    std::atomic<bool> pendingPointerEventsFlush { false };
+    void requestPointerEventsFlush() noexcept;
     bool isGraphicBackendInitialized { false };
 
     bool initGraphicBackend();
@@ -58,6 +72,20 @@ LPRIVATE_CLASS(LCompositor)
         PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC glEGLImageTargetRenderbufferStorageOES { NULL };
         PFNGLEGLIMAGETARGETTEXTURE2DOESPROC glEGLImageTargetTexture2DOES { NULL };
 
+        // GL_EXT_disjoint_timer_query, used by LScene render profiling
+        PFNGLGENQUERIESEXTPROC glGenQueriesEXT { NULL };
+        PFNGLDELETEQUERIESEXTPROC glDeleteQueriesEXT { NULL };
+        PFNGLBEGINQUERYEXTPROC glBeginQueryEXT { NULL };
+        PFNGLENDQUERYEXTPROC glEndQueryEXT { NULL };
+        PFNGLGETQUERYOBJECTUIVEXTPROC glGetQueryObjectuivEXT { NULL };
+        PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64vEXT { NULL };
+
+        // EGL_KHR_fence_sync, used to measure GPU completion for render delay
+        bool KHR_fence_sync { false };
+        PFNEGLCREATESYNCKHRPROC eglCreateSyncKHR { NULL };
+        PFNEGLCLIENTWAITSYNCKHRPROC eglClientWaitSyncKHR { NULL };
+        PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR { NULL };
+
         EGLDisplay mainEGLDisplay { EGL_NO_DISPLAY };
         EGLContext mainEGLContext { EGL_NO_CONTEXT };
         LGraphicBackendInterface *graphicBackend { nullptr };
@@ -98,7 +126,21 @@ LPRIVATE_CLASS(LCompositor)
         UpdateLayers    = static_cast<UInt8>(1) << 1
     };
 
-    void notifyOrderChangeFromSurface(LSurface *from);
+    /* Order changes are collected while dispatching and delivered once from processLoop(), only to the
+     * surfaces whose previous surface changed since their last orderChanged() (or forced, see LSurfacePrivate::setParent()) */
+    std::vector<LWeak<LSurface>> pendingOrderChanges;
+    void queueOrderChange(LSurface *surface, bool force = false) noexcept;
+    void notifyOrderChanges() noexcept;
+
+    // Outputs whose exclusive zones changed during this main loop iteration, see LOutputPrivate::updateExclusiveZones()
+    std::vector<LWeak<LOutput>> pendingExclusiveZonesNotify;
+    void queueExclusiveZonesNotify(LOutput *output) noexcept;
+    void notifyExclusiveZones() noexcept;
+
+    /* Order-maintenance keys, increasing along the surfaces list so the relative order of
+     * two surfaces is known in O(1). Must be called after inserting a surface into the list */
+    void updateOrderKey(LSurface *surface) noexcept;
+    void relabelSurfaces() noexcept;
     void insertSurfaceAfter(LSurface *prevSurface, LSurface *surfaceToInsert, LBitset<InsertOptions> options);
     void insertSurfaceBefore(LSurface *nextSurface, LSurface *surfaceToInsert, LBitset<InsertOptions> options);
 
@@ -109,6 +151,41 @@ LPRIVATE_CLASS(LCompositor)
     std::vector<LTexture*>textures;
     std::vector<LAnimation*>animations;
     std::vector<LTimer*>oneShotTimers;
+    std::unique_ptr<LAsyncTextureLoader> asyncTextureLoader;
+    UInt32 asyncTextureUploadBudget { 16 * 1024 * 1024 };
+    std::vector<LRenderBuffer*> surfaceCapturePool;
+
+    /* Events sent while dispatching (buffer releases, etc) are flushed once at the end of processLoop(),
+     * wl_display_flush_clients() only writes to clients with queued events */
+    std::atomic<bool> pendingClientsFlush { false };
+    void flushClientsLater() noexcept
+    {
+        pendingClientsFlush = true;
+        loopCounters.deferredFlushes++;
+    }
+
+    /* Surfaces with a DMA buffer commit waiting for its fences, in commit order, see LSurfacePrivate::deferCommit().
+     * The protocol logger applies them before any other request of the same client is handled */
+    bool dmaBufCommitQueueEnabled { true };
+    std::vector<LSurface*> deferredCommitSurfaces;
+    wl_protocol_logger *deferredCommitsLogger { nullptr };
+    static void onDeferredCommitsLog(void *data, wl_protocol_logger_type type, const wl_protocol_logger_message *message);
+
+    // Loggers can't be removed while libwayland iterates them, so it's done from processLoop()
+    void removeUnusedDeferredCommitsLogger() noexcept
+    {
+        if (deferredCommitsLogger && deferredCommitSurfaces.empty())
+        {
+            wl_protocol_logger_destroy(deferredCommitsLogger);
+            deferredCommitsLogger = nullptr;
+        }
+    }
+
+    // Releases the frame callbacks of surfaces not being displayed
+    std::unique_ptr<LTimer> hiddenSurfacesFrameTimer;
+    UInt32 hiddenSurfacesFrameRate { 1 };
+    void scheduleHiddenSurfacesFrames() noexcept;
+    void sendHiddenSurfacesFrames() noexcept;
 
     bool runningAnimations();
     void processAnimations();
@@ -137,6 +214,7 @@ LPRIVATE_CLASS(LCompositor)
         dev_t device;
         wl_array formatIndices;
         wl_array scanoutIndices;
+        wl_array allIndices;
     } dmaFeedback;
 
     void initDMAFeedback() noexcept;
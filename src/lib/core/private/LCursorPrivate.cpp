@@ -1,4 +1,5 @@
 #include <private/LCursorPrivate.h>
+#include <private/LTexturePrivate.h>
 
 LCursor::LCursorPrivate::LCursorPrivate() : defaultTexture() {}
 
@@ -124,14 +125,7 @@ void texture2Buffer(LCursor *cursor, const LSizeF &size, LTransform transform) n
     {
         glReadPixels(0, 0, 64, 64, GL_RGBA , GL_UNSIGNED_BYTE, cursor->imp()->buffer);
 
-        UInt8 tmp;
-
         // Convert to RGBA8888
-        for (Int32 i = 0; i < 64*64*4; i+=4)
-        {
-            tmp = cursor->imp()->buffer[i];
-            cursor->imp()->buffer[i] = cursor->imp()->buffer[i+2];
-            cursor->imp()->buffer[i+2] = tmp;
-        }
+        LTexture::LTexturePrivate::swapRedBlue(cursor->imp()->buffer, 64 * 64);
     }
 }
@@ -0,0 +1,34 @@
+#ifndef LORDERCHANGEFILTER_H
+#define LORDERCHANGEFILTER_H
+
+namespace Louvre
+{
+    /**
+     * Decides which surfaces of a batch of order changes must receive orderChanged().
+     *
+     * Surfaces must be passed from bottom to top. A surface is notified when forced, when its previous surface
+     * differs from the last notified one, or when its previous surface was notified in the same batch, since
+     * handlers usually restack relative to it (e.g. raising B and then C in A B C D E leaves C after B, but B moved).
+     */
+    template<class T>
+    class LOrderChangeFilter
+    {
+    public:
+        bool shouldNotify(const T *surface, const T *prev, const T *notifiedPrev, bool forced) noexcept
+        {
+            // The previous surface, if queued, is always the one evaluated right before
+            if (forced || notifiedPrev != prev || (prev && prev == m_lastNotified))
+            {
+                m_lastNotified = surface;
+                return true;
+            }
+
+            return false;
+        }
+
+    private:
+        const T *m_lastNotified { nullptr };
+    };
+}
+
+#endif // LORDERCHANGEFILTER_H
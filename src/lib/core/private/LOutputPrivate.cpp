@@ -3,6 +3,7 @@
 #include <protocols/ScreenCopy/GScreenCopyManager.h>
 #include <protocols/SessionLock/RSessionLock.h>
 #include <private/LOutputPrivate.h>
+#include <private/LSeatPrivate.h>
 #include <private/LCompositorPrivate.h>
 #include <private/LPainterPrivate.h>
 #include <private/LCursorPrivate.h>
@@ -13,9 +14,11 @@
 #include <LExclusiveZone.h>
 #include <LOutputMode.h>
 #include <LLayerRole.h>
+#include <LToplevelRole.h>
 #include <LSeat.h>
 #include <LGlobal.h>
 #include <LTime.h>
+#include <unistd.h>
 
 using namespace Louvre::Protocols::Wayland;
 
@@ -73,16 +76,17 @@ void LOutput::LOutputPrivate::damageToBufferCoords() noexcept
         damage.offset(-rect.pos().x(), -rect.pos().y());
         damage.transform(rect.size(), transform);
 
-        LRegion tmp; Int32 n;
+        bufferDamage.clear();
+        Int32 n;
         const LBox *box { damage.boxes(&n) };
         while (n > 0)
         {
-            tmp.addRect(floorf(Float32(box->x1) * fractionalScale) - 2, floorf(Float32(box->y1) * fractionalScale) - 2,
-                        ceilf(Float32(box->x2 - box->x1) * fractionalScale) + 4, ceilf(Float32(box->y2 - box->y1) * fractionalScale) + 4);
+            bufferDamage.addRect(floorf(Float32(box->x1) * fractionalScale) - 2, floorf(Float32(box->y1) * fractionalScale) - 2,
+                                 ceilf(Float32(box->x2 - box->x1) * fractionalScale) + 4, ceilf(Float32(box->y2 - box->y1) * fractionalScale) + 4);
             n--; box++;
         }
 
-        damage = std::move(tmp);
+        std::swap(damage.m_region, bufferDamage.m_region);
         damage.clip(LRect(0, output->currentMode()->sizeB()));
 
         if (output->hasBufferDamageSupport())
@@ -252,6 +256,13 @@ void LOutput::LOutputPrivate::backendPaintGL()
     if (output->imp()->state != LOutput::Initialized)
         return;
 
+    // Lets the main thread deliver coalesced pointer events while waiting for the deadline and the lock
+    compositor()->imp()->requestPointerEventsFlush();
+
+    // Must be done before locking to avoid blocking the main thread
+    if (stateFlags.check(RenderDelay))
+        waitForRenderDeadline();
+
     if (callLock)
         compositor()->imp()->lock();
 
@@ -317,11 +328,15 @@ void LOutput::LOutputPrivate::backendPaintGL()
         scanout[0].surface.reset();
     }
 
+    const UInt64 regionAllocationsPrev { LRegion::allocationsCount() };
+
     /* Let users do their rendering*/
     stateFlags.add(IsInPaintGL);
     output->paintGL();
     stateFlags.remove(IsInPaintGL);
 
+    updateScanoutCandidate();
+
     /* Force repaint if there are unreleased buffers */
     if (scanout[0].buffer || scanout[1].buffer)
         output->repaint();
@@ -349,14 +364,84 @@ void LOutput::LOutputPrivate::backendPaintGL()
         stateFlags.remove(IsBlittingFramebuffers);
     }
 
+    regionAllocations = LRegion::allocationsCount() - regionAllocationsPrev;
+
     /* Ensure clients receive frame callbacks and pending roles configurations on time */
     compositor()->flushClients();
 
     /* Destroy render buffers created from this thread and marked as destroyed by the user */
     compositor()->imp()->destroyPendingRenderBuffers(&output->imp()->threadId);
 
+    // Both do nothing unless waitForRenderDeadline() was called for this frame
+    submitRenderFence();
+
     if (callLock)
         compositor()->imp()->unlock();
+
+    // Waits for the GPU, so the main thread must not be blocked
+    finishRenderDeadline();
+}
+
+static UInt64 timespecToUs(const timespec &time) noexcept
+{
+    return UInt64(time.tv_sec) * 1000000 + UInt64(time.tv_nsec) / 1000;
+}
+
+void LOutput::LOutputPrivate::waitForRenderDeadline() noexcept
+{
+    renderStartUs = timespecToUs(LTime::ns());
+
+    if (!output->vSyncEnabled())
+        return;
+
+    pageflipMutex.lock();
+    const UInt64 lastVblank { timespecToUs(presentationTime.time) };
+    UInt32 period { presentationTime.period / 1000 };
+    pageflipMutex.unlock();
+
+    // Some backends don't provide the refresh period
+    if (period == 0 && output->currentMode() && output->currentMode()->refreshRate() > 0)
+        period = 1000000000 / output->currentMode()->refreshRate();
+
+    const UInt64 start { frameScheduler.schedule(renderStartUs, lastVblank, period) };
+
+    if (start > renderStartUs)
+    {
+        usleep(start - renderStartUs);
+        renderStartUs = timespecToUs(LTime::ns());
+    }
+}
+
+void LOutput::LOutputPrivate::submitRenderFence() noexcept
+{
+    if (renderStartUs == 0)
+        return;
+
+    if (compositor()->imp()->KHR_fence_sync)
+        renderFence = compositor()->imp()->eglCreateSyncKHR(eglGetCurrentDisplay(), EGL_SYNC_FENCE_KHR, NULL);
+
+    glFlush();
+}
+
+void LOutput::LOutputPrivate::finishRenderDeadline() noexcept
+{
+    if (renderStartUs == 0)
+        return;
+
+    // The frame is done when the GPU finished executing it, not when its commands were submitted
+    if (renderFence != EGL_NO_SYNC_KHR)
+    {
+        auto &c { *compositor()->imp() };
+        c.eglClientWaitSyncKHR(eglGetCurrentDisplay(), renderFence, 0, 100000000);
+        c.eglDestroySyncKHR(eglGetCurrentDisplay(), renderFence);
+        renderFence = EGL_NO_SYNC_KHR;
+    }
+    else
+        glFinish();
+
+    const UInt64 end { timespecToUs(LTime::ns()) };
+    frameScheduler.addRenderDuration(end - renderStartUs);
+    renderStartUs = 0;
 }
 
 void LOutput::LOutputPrivate::backendResizeGL()
@@ -421,6 +506,7 @@ void LOutput::LOutputPrivate::backendUninitializeGL()
     /* Just in case there is a pending user buffer release */
     releaseScanoutBuffer(0);
     releaseScanoutBuffer(1);
+    setScanoutCandidate(nullptr);
 
     compositor()->flushClients();
     output->imp()->state = LOutput::Uninitialized;
@@ -436,7 +522,16 @@ void LOutput::LOutputPrivate::backendPageFlipped()
     pageflipMutex.lock();
     stateFlags.add(HasUnhandledPresentationTime);
     frame++;
+
+    // Misses are only visible from the actual presentation time
+    if (stateFlags.check(RenderDelay))
+        frameScheduler.framePresented(timespecToUs(presentationTime.time));
+
     pageflipMutex.unlock();
+    compositor()->imp()->hasUnhandledPresentationTime.store(true);
+
+    // Events received during the last refresh, delivered early enough for the next frame
+    compositor()->imp()->requestPointerEventsFlush();
 }
 
 void LOutput::LOutputPrivate::updateRect()
@@ -573,16 +668,11 @@ void LOutput::LOutputPrivate::updateExclusiveZones() noexcept
 {
     exclusiveEdges = {0, 0, 0, 0};
 
-    LRect prev;
-
     for (LExclusiveZone *zone : exclusiveZones)
     {
         if (zone->size() <= 0)
             continue;
 
-        if (zone->m_onRectChangeCallback)
-            prev = zone->m_rect;
-
         switch (zone->edge())
         {
         case LEdgeNone:
@@ -616,24 +706,15 @@ void LOutput::LOutputPrivate::updateExclusiveZones() noexcept
             zone->m_rect.setY(rect.h() - exclusiveEdges.bottom);
             break;
         }
-
-        if (zone->m_onRectChangeCallback && prev != zone->m_rect)
-            zone->m_onRectChangeCallback(zone);
     }
 
-    prev = availableGeometry;
     availableGeometry.setX(exclusiveEdges.left);
     availableGeometry.setY(exclusiveEdges.top);
     availableGeometry.setW(rect.w() - exclusiveEdges.left - exclusiveEdges.right);
     availableGeometry.setH(rect.h() - exclusiveEdges.top - exclusiveEdges.bottom);
 
-    const bool availableGeometryChanged { availableGeometry != prev };
-
     for (LExclusiveZone *zone : exclusiveZones)
     {
-        if (zone->m_onRectChangeCallback)
-            prev = zone->m_rect;
-
         if (zone->edge() == LEdgeNone)
         {
             if (zone->size() >= 0)
@@ -648,13 +729,31 @@ void LOutput::LOutputPrivate::updateExclusiveZones() noexcept
             else if ( zone->size() < 0)
                 zone->m_rect = LRect(0, rect.size());
         }
+    }
+
+    compositor()->imp()->queueExclusiveZonesNotify(output);
+}
+
+void LOutput::LOutputPrivate::notifyExclusiveZones() noexcept
+{
+    stateFlags.remove(ExclusiveZonesNotifyPending);
 
-        if (zone->m_onRectChangeCallback && prev != zone->m_rect)
+    for (LExclusiveZone *zone : exclusiveZones)
+    {
+        if (zone->m_notifiedRect == zone->m_rect)
+            continue;
+
+        zone->m_notifiedRect = zone->m_rect;
+
+        if (zone->m_onRectChangeCallback)
             zone->m_onRectChangeCallback(zone);
     }
 
-    if (availableGeometryChanged)
+    if (notifiedAvailableGeometry != availableGeometry)
+    {
+        notifiedAvailableGeometry = availableGeometry;
         output->availableGeometryChanged();
+    }
 }
 
 void LOutput::LOutputPrivate::updateLayerSurfacesMapping() noexcept
@@ -706,3 +805,60 @@ skipRelease:
     scanout[index].buffer = nullptr;
     scanout[index].surface.reset();
 }
+
+void LOutput::LOutputPrivate::updateScanoutCandidate() noexcept
+{
+    LSurface *candidate { nullptr };
+
+    for (auto it = compositor()->surfaces().rbegin(); it != compositor()->surfaces().rend(); it++)
+    {
+        LSurface *s { *it };
+
+        if (!s->mapped() || s->minimized() || s->cursorRole())
+            continue;
+
+        const LRect surfaceRect { s->rolePos(), s->size() };
+
+        if (!surfaceRect.intersects(rect, false))
+            continue;
+
+        // The topmost surface intersecting the output decides, using the same requirements as LScene's auto scanout
+        if (s->toplevel() && s->toplevel()->fullscreen() && surfaceRect == rect && s->hasBuffer() &&
+            output->currentMode() && s->sizeB() == output->currentMode()->sizeB() &&
+            output->transform() == LTransform::Normal && s->bufferTransform() == LTransform::Normal)
+            candidate = s;
+
+        break;
+    }
+
+    setScanoutCandidate(candidate);
+}
+
+void LOutput::LOutputPrivate::setScanoutCandidate(LSurface *surface) noexcept
+{
+    if (scanoutCandidate.get() == surface)
+        return;
+
+    LSurface *prev { scanoutCandidate };
+    scanoutCandidate.reset(surface);
+
+    if (prev)
+    {
+        bool candidateInOtherOutput { false };
+
+        for (LOutput *o : compositor()->outputs())
+        {
+            if (o->imp()->scanoutCandidate == prev)
+            {
+                candidateInOtherOutput = true;
+                break;
+            }
+        }
+
+        if (!candidateInOtherOutput)
+            prev->imp()->setScanoutFeedback(false);
+    }
+
+    if (surface)
+        surface->imp()->setScanoutFeedback(true);
+}
@@ -8,6 +8,9 @@
 #include <LSurface.h>
 #include <LGammaTable.h>
 #include <LMargins.h>
+#include <LFrameScheduler.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <atomic>
 #include <list>
 #include <mutex>
@@ -51,6 +54,8 @@ LPRIVATE_CLASS_NO_COPY(LOutput)
         IsBlittingFramebuffers              = static_cast<UInt32>(1) << 11,
         IsInPaintGL                         = static_cast<UInt32>(1) << 12,
         HasScanoutBuffer                    = static_cast<UInt32>(1) << 13,
+        RenderDelay                         = static_cast<UInt32>(1) << 14,
+        ExclusiveZonesNotifyPending         = static_cast<UInt32>(1) << 15,
     };
 
     LOutputPrivate(LOutput *output);
@@ -97,6 +102,20 @@ LPRIVATE_CLASS_NO_COPY(LOutput)
      * the graphic backend uses DUMB buffers or CPU copy. */
     UInt64 frame { 0 };
     LRegion damage;
+
+    // Kept to reuse its box storage, see damageToBufferCoords()
+    LRegion bufferDamage;
+
+    // LRegion allocations made by the last frame, see LOutput::regionAllocations()
+    UInt64 regionAllocations { 0 };
+
+    // Render delay (late frame scheduling), only accessed from the output thread
+    LFrameScheduler frameScheduler;
+    UInt64 renderStartUs { 0 };
+    EGLSyncKHR renderFence { EGL_NO_SYNC_KHR };
+    void waitForRenderDeadline() noexcept;
+    void submitRenderFence() noexcept;
+    void finishRenderDeadline() noexcept;
     void damageToBufferCoords() noexcept;
     void blitFramebuffers() noexcept;
     void blitFractionalScaleFb(bool cursorOnly) noexcept;
@@ -141,6 +160,12 @@ LPRIVATE_CLASS_NO_COPY(LOutput)
     bool isBufferScannedByOtherOutputs(wl_buffer *buffer) const noexcept;
     void releaseScanoutBuffer(UInt8 index) noexcept;
 
+    /* Topmost fullscreen toplevel covering the entire output with nothing above it.
+     * Its linux-dmabuf surface feedback advertises the scanout tranche first. */
+    LWeak<LSurface> scanoutCandidate;
+    void updateScanoutCandidate() noexcept;
+    void setScanoutCandidate(LSurface *surface) noexcept;
+
     // API for the graphic backend
 
     void *graphicBackendData {nullptr};
@@ -157,7 +182,14 @@ LPRIVATE_CLASS_NO_COPY(LOutput)
     std::list<LExclusiveZone*> exclusiveZones;
     LRect availableGeometry;
     LMargins exclusiveEdges;
+
+    // Last values notified with availableGeometryChanged() and LExclusiveZone callbacks, see notifyExclusiveZones()
+    LRect notifiedAvailableGeometry;
+
+    /* Recalculates the zone rects and availableGeometry immediately, but their change notifications
+     * are queued, so multiple updates within the same main loop iteration notify once */
     void updateExclusiveZones() noexcept;
+    void notifyExclusiveZones() noexcept;
     void updateLayerSurfacesMapping() noexcept;
 };
 
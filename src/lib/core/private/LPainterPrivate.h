@@ -1,8 +1,6 @@
 #ifndef LPAINTERPRIVATE_H
 #define LPAINTERPRIVATE_H
 
-#define LPAINTER_TRACK_UNIFORMS 1
-
 #include <private/LTexturePrivate.h>
 #include <private/LOutputPrivate.h>
 #include <LOutputFramebuffer.h>
@@ -10,6 +8,7 @@
 #include <LRect.h>
 #include <GL/gl.h>
 #include <GLES2/gl2.h>
+#include <array>
 
 using namespace Louvre;
 
@@ -22,22 +21,60 @@ enum ShaderMode : GLint
     ColorMode = 2
 };
 
+// Flags used to select a specialized program variant
+enum ProgramFlags : UInt8
+{
+    ExternalOESProgram          = static_cast<UInt8>(1) << 0,
+    ColorModeProgram            = static_cast<UInt8>(1) << 1,
+    TexColorProgram             = static_cast<UInt8>(1) << 2,
+    PremultipliedAlphaProgram   = static_cast<UInt8>(1) << 3,
+    ColorFactorProgram          = static_cast<UInt8>(1) << 4,
+    AlphaProgram                = static_cast<UInt8>(1) << 5,
+    Has90DegProgram             = static_cast<UInt8>(1) << 6,
+    BlurProgram                 = static_cast<UInt8>(1) << 7
+};
+
+static constexpr UInt32 ProgramVariantsCount { 256 };
+
+// Max taps of the separable blur kernel, each one samples two texels except the center
+static constexpr UInt32 MaxBlurTaps { 16 };
+static constexpr Float32 MaxBlurRadiusB { 2.f * Float32(MaxBlurTaps - 1) };
+
 struct Uniforms
 {
-    GLuint
-        texSize,
+    GLint
         srcRect,
         activeTexture,
-        mode,
         color,
-        colorFactorEnabled,
-        texColorEnabled,
         alpha,
-        premultipliedAlpha,
-        has90deg;
-} uniforms, uniformsExternal;
+        blurStep,
+        blurWeights,
+        blurOffsets,
+        blurTaps;
+};
+
+// Uniform values currently stored in a program
+struct UniformsState
+{
+    LRectF srcRect;
+    GLint activeTexture { 0 };
+    LRGBF color { 1.f, 1.f, 1.f };
+    GLfloat alpha { 1.f };
+    LPointF blurStep;
+    UInt32 blurKernelSerial { 0 };
+};
+
+struct ProgramVariant
+{
+    GLuint id { 0 };
+    bool failed { false };
+    bool synced { false };
+    Uniforms uniforms;
+    UniformsState state;
+};
 
-Uniforms *currentUniforms;
+std::array<ProgramVariant, ProgramVariantsCount> programs;
+ProgramVariant *currentVariant { nullptr };
 
 struct UniformsScaler
 {
@@ -47,7 +84,8 @@ struct UniformsScaler
         activeTexture,
         pixelSize,
         samplerBounds,
-        iters;
+        iters,
+        mode;
 } uniformsScaler, uniformsScalerExternal;
 
 UniformsScaler *currentUniformsScaler;
@@ -77,28 +115,36 @@ static inline GLfloat square[]
     1.0f,  1.0f,   1.f, 1.f  // TR
 };
 
-GLuint vertexShader, fragmentShader, fragmentShaderExternal, fragmentShaderScaler, fragmentShaderScalerExternal;
+GLuint vertexShaderScaler, fragmentShaderScaler, fragmentShaderScalerExternal;
 
+// Requested shader state, applied lazily by bindProgramVariant() before each draw call
 struct ShaderState
 {
-    LSizeF texSize;
     LRectF srcRect;
-    GLuint activeTexture;
-    ShaderMode mode;
-    LRGBF color;
+    GLint activeTexture { 0 };
+    ShaderMode mode { TextureMode };
+    LRGBF color { 1.f, 1.f, 1.f };
     bool colorFactorEnabled { false };
     bool texColorEnabled { false };
     bool premultipliedAlpha { false };
     bool has90deg { false };
-    GLfloat alpha;
-    GLfloat scale;
-};
+    GLfloat alpha { 1.f };
+    bool blur { false };
+    LPointF blurStep;
+} state;
 
-ShaderState state, stateExternal;
-ShaderState *currentState;
+// Normalized gaussian weights and offsets of the linearly interpolated blur taps
+struct BlurKernel
+{
+    std::array<GLfloat, MaxBlurTaps> weights;
+    std::array<GLfloat, MaxBlurTaps> offsets;
+    GLint taps { 0 };
+    Float32 radiusB { -1.f };
+    UInt32 serial { 1 };
+} blurKernel;
 
 // Program
-GLuint programObject, programObjectExternal, programObjectScaler, programObjectScalerExternal, currentProgram;
+GLuint programObjectScaler, programObjectScalerExternal, currentProgram { 0 };
 LOutput *output = nullptr;
 LPainter *painter;
 LFramebuffer *fb = nullptr;
@@ -109,6 +155,8 @@ struct OpenGLExtensions
 {
     bool EXT_read_format_bgra;
     bool OES_EGL_image;
+    bool OES_texture_npot;
+    bool EXT_disjoint_timer_query;
 } openGLExtensions;
 
 void updateExtensions() noexcept;
@@ -122,136 +170,103 @@ struct CPUFormats
 } cpuFormats;
 
 void updateCPUFormats() noexcept;
-void setupProgram() noexcept;
 void setupProgramScaler() noexcept;
+bool createProgramVariant(UInt8 key) noexcept;
+bool updateMipmaps(LTexture *texture, GLuint id) noexcept;
+void bindProgramVariant() noexcept;
 
-void shaderSetPremultipliedAlpha(bool premultipliedAlpha) noexcept
+UInt8 programKey() const noexcept
 {
-    if (currentState->premultipliedAlpha != premultipliedAlpha)
-    {
-        currentState->premultipliedAlpha = premultipliedAlpha;
-        glUniform1i(currentUniforms->premultipliedAlpha, premultipliedAlpha);
-    }
+    if (state.mode == ColorMode)
+        return ColorModeProgram;
+
+    UInt8 key { 0 };
+
+    if (textureTarget == GL_TEXTURE_EXTERNAL_OES)
+        key |= ExternalOESProgram;
+
+    if (state.has90deg)
+        key |= Has90DegProgram;
+
+    if (state.alpha != 1.f)
+        key |= AlphaProgram;
+
+    if (state.texColorEnabled)
+        return key | TexColorProgram;
+
+    if (state.blur)
+        key |= BlurProgram;
+
+    if (state.premultipliedAlpha)
+        key |= PremultipliedAlphaProgram;
+
+    if (state.colorFactorEnabled)
+        key |= ColorFactorProgram;
+
+    return key;
 }
 
-void shaderSetTexSize(const LSizeF &size) noexcept
+void shaderSetPremultipliedAlpha(bool premultipliedAlpha) noexcept
 {
-    if (currentState->texSize != size)
-    {
-        currentState->texSize = size;
-        glUniform2f(currentUniforms->texSize, size.w(), size.h());
-    }
+    state.premultipliedAlpha = premultipliedAlpha;
 }
 
 void shaderSetSrcRect(const LRectF &rect) noexcept
 {
-    if (currentState->srcRect != rect)
-    {
-        currentState->srcRect = rect;
-        glUniform4f(currentUniforms->srcRect, rect.x(), rect.y(), rect.w(), rect.h());
-    }
+    state.srcRect = rect;
 }
 
-void shaderSetActiveTexture(GLuint unit) noexcept
+void shaderSetActiveTexture(GLint unit) noexcept
 {
-    if (currentState->activeTexture != unit)
-    {
-        currentState->activeTexture = unit;
-        glUniform1i(currentUniforms->activeTexture, unit);
-    }
+    state.activeTexture = unit;
 }
 
 void shaderSetMode(ShaderMode mode) noexcept
 {
-    if (currentState->mode != mode)
-    {
-        currentState->mode = mode;
-        glUniform1i(currentUniforms->mode, mode);
-    }
+    state.mode = mode;
 }
 
 void shaderSetColor(const LRGBF &color) noexcept
 {
-    if (currentState->color != color)
-    {
-        currentState->color = color;
-        glUniform3f(currentUniforms->color, color.r, color.g, color.b);
-    }
+    state.color = color;
 }
 
 void shaderSetColorFactorEnabled(bool enabled) noexcept
 {
-    if (currentState->colorFactorEnabled != enabled)
-    {
-        currentState->colorFactorEnabled = enabled;
-        glUniform1i(currentUniforms->colorFactorEnabled, enabled);
-    }
+    state.colorFactorEnabled = enabled;
 }
 
 void shaderSetTexColorEnabled(bool enabled) noexcept
 {
-    if (currentState->texColorEnabled != enabled)
-    {
-        currentState->texColorEnabled = enabled;
-        glUniform1i(currentUniforms->texColorEnabled, enabled);
-    }
+    state.texColorEnabled = enabled;
 }
 
 void shaderSetHas90Deg(bool enabled) noexcept
 {
-    if (currentState->has90deg != enabled)
-    {
-        currentState->has90deg = enabled;
-        glUniform1i(currentUniforms->has90deg, enabled);
-    }
+    state.has90deg = enabled;
 }
 
 void shaderSetAlpha(Float32 a) noexcept
 {
-    if (currentState->alpha != a)
-    {
-        currentState->alpha = a;
-        glUniform1f(currentUniforms->alpha, a);
-    }
+    state.alpha = a;
 }
 
+/* Replaces the texture sampling with the current blur kernel applied along step,
+ * which is the distance between texels in normalized texture coordinates */
+void shaderSetBlur(bool enabled, const LPointF &step = LPointF()) noexcept
+{
+    state.blur = enabled;
+    state.blurStep = step;
+}
+
+// Gaussian kernel covering radiusB texels, clamped to MaxBlurRadiusB
+void setBlurKernel(Float32 radiusB) noexcept;
+
 // GL params
 
 void switchTarget(GLenum target) noexcept
 {
-    if (textureTarget != target)
-    {
-        if (target == GL_TEXTURE_2D)
-        {
-            currentProgram = programObject;
-            currentUniforms = &uniforms;
-            glUseProgram(currentProgram);
-            currentState = &state;
-            shaderSetColorFactorEnabled(stateExternal.colorFactorEnabled);
-            shaderSetAlpha(stateExternal.alpha);
-            shaderSetMode(stateExternal.mode);
-            shaderSetColor(stateExternal.color);
-            shaderSetTexColorEnabled(stateExternal.texColorEnabled);
-            shaderSetPremultipliedAlpha(stateExternal.premultipliedAlpha);
-            shaderSetHas90Deg(stateExternal.has90deg);
-        }
-        else
-        {
-            currentProgram = programObjectExternal;
-            currentUniforms = &uniformsExternal;
-            glUseProgram(currentProgram);
-            currentState = &stateExternal;
-            shaderSetColorFactorEnabled(state.colorFactorEnabled);
-            shaderSetAlpha(state.alpha);
-            shaderSetMode(state.mode);
-            shaderSetColor(state.color);
-            shaderSetTexColorEnabled(state.texColorEnabled);
-            shaderSetPremultipliedAlpha(state.premultipliedAlpha);
-            shaderSetHas90Deg(state.has90deg);
-        }
-
-        textureTarget = target;
-    }
+    textureTarget = target;
 }
 
 void setViewport(Int32 x, Int32 y, Int32 w, Int32 h) noexcept
@@ -350,7 +365,7 @@ void setViewport(Int32 x, Int32 y, Int32 w, Int32 h) noexcept
     glScissor(x, y, w, h);
     glViewport(x, y, w, h);
 
-    if (currentState->mode == TextureMode)
+    if (state.mode == TextureMode)
     {
         shaderSetSrcRect(LRectF(
             (Float32(x) - srcRect.x()) / srcRect.w(),
@@ -26,6 +26,14 @@ LPRIVATE_CLASS(LPointer)
     LBitset<StateFlags> state { NaturalScrollX | NaturalScrollY };
     Float32 axisXprev;
     Float32 axisYprev;
+
+    // An axis dropping to zero is sent as an axis stop (see LPointer::sendScrollEvent()), so such events must not be merged
+    static bool isScrollStop(const LPointF &axes, const LPointF &prevAxes) noexcept
+    {
+        return (axes.x() == 0.f && axes.y() == 0.f) ||
+               (axes.x() == 0.f && prevAxes.x() != 0.f) ||
+               (axes.y() == 0.f && prevAxes.y() != 0.f);
+    }
 };
 
 #endif // LPOINTERPRIVATE_H
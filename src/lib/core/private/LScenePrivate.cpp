@@ -1,4 +1,7 @@
 #include <private/LScenePrivate.h>
+#include <private/LOutputPrivate.h>
+#include <private/LCompositorPrivate.h>
+#include <private/LPainterPrivate.h>
 #include <LSceneTouchPoint.h>
 #include <LOutput.h>
 #include <LCompositor.h>
@@ -6,6 +9,9 @@
 #include <LSurfaceView.h>
 #include <LFramebuffer.h>
 #include <LCursor.h>
+#include <LOutputMode.h>
+#include <LSurface.h>
+#include <LTime.h>
 #include <LUtils.h>
 #include <LLog.h>
 
@@ -259,3 +265,223 @@ listChangedErr:
     handleTouchDown(&this->view);
     return false;
 }
+
+LRegion LScene::LScenePrivate::visibleRegion(LView *view) noexcept
+{
+    LRegion region { LRect(view->pos(), view->size()) };
+
+    if (view->clippingEnabled())
+        region.clip(view->clippingRect());
+
+    if (view->parent() && view->parentClippingEnabled())
+        region.clip(view->parent()->pos(), view->parent()->size());
+
+    return region;
+}
+
+LView *LScene::LScenePrivate::topmostVisibleView(LView *view, const LRect &rect) noexcept
+{
+    for (std::list<LView*>::const_reverse_iterator it = view->children().crbegin(); it != view->children().crend(); it++)
+    {
+        LView *child { *it };
+
+        if (!child->mapped())
+            continue;
+
+        // Children are drawn on top of their parent
+        if (child->type() != LView::SceneType)
+            if (LView *top = topmostVisibleView(child, rect))
+                return top;
+
+        if (!child->isRenderable() || child->opacity() <= 0.f || child->colorFactor().a <= 0.f || child->size().area() == 0)
+            continue;
+
+        LRegion region { visibleRegion(child) };
+        region.clip(rect);
+
+        if (!region.empty())
+            return child;
+    }
+
+    return nullptr;
+}
+
+bool LScene::LScenePrivate::tryAutoScanout(LOutput *output) noexcept
+{
+    if (output->usingFractionalScale() || output->transform() != LTransform::Normal || !output->imp()->screenshotRequests.empty())
+        return false;
+
+    if (cursor()->visible() && cursor()->enabled(output) && !cursor()->hwCompositingEnabled(output) && cursor()->rect().intersects(output->rect()))
+        return false;
+
+    LView *top { topmostVisibleView(&view, output->rect()) };
+
+    if (!top || top->type() != LView::SurfaceType)
+        return false;
+
+    LSurfaceView *surfaceView { static_cast<LSurfaceView*>(top) };
+    LSurface *surface { surfaceView->surface() };
+
+    if (!surface || !surface->texture() || surface->bufferTransform() != LTransform::Normal)
+        return false;
+
+    if (top->pos() != output->pos() || top->size() != output->size())
+        return false;
+
+    if (top->opacity() < 1.f || ((top->scalingEnabled() || top->parentScalingEnabled()) && top->scalingVector() != LSizeF(1.f, 1.f)))
+        return false;
+
+    const LRGBAF &colorFactor { top->colorFactor() };
+
+    if (colorFactor.r != 1.f || colorFactor.g != 1.f || colorFactor.b != 1.f || colorFactor.a != 1.f)
+        return false;
+
+    // Must be entirely opaque and not clipped
+    if (!top->translucentRegion() || !top->translucentRegion()->empty())
+        return false;
+
+    LRegion uncovered { output->rect() };
+    uncovered.subtractRegion(visibleRegion(top));
+
+    if (!uncovered.empty())
+        return false;
+
+    // The whole buffer must be displayed 1:1
+    const LRectF &src { surfaceView->srcRect() };
+    const Float32 scale { Float32(surface->bufferScale()) };
+
+    if (src.x() != 0.f || src.y() != 0.f ||
+        src.w() * scale != Float32(surface->sizeB().w()) ||
+        src.h() * scale != Float32(surface->sizeB().h()) ||
+        surface->sizeB() != output->currentMode()->sizeB())
+        return false;
+
+    // Returns false if the format or buffer type is not supported
+    return output->setCustomScanoutBuffer(surface->texture());
+}
+
+LScene::LScenePrivate::ProfilerSample LScene::LScenePrivate::beginViewProfiling(LPainter *painter) noexcept
+{
+    ProfilerSample sample;
+    auto &ptd { profilerThreadsMap[std::this_thread::get_id()] };
+    auto &c { *compositor()->imp() };
+
+    // Timer queries can't be nested, only the outermost view is measured on the GPU
+    if (ptd.activeQuery == 0 && painter->imp()->openGLExtensions.EXT_disjoint_timer_query && c.glBeginQueryEXT)
+    {
+        if (ptd.freeQueries.empty())
+        {
+            GLuint query { 0 };
+            c.glGenQueriesEXT(1, &query);
+            ptd.freeQueries.push_back(query);
+        }
+
+        ptd.activeQuery = ptd.freeQueries.back();
+        ptd.freeQueries.pop_back();
+        c.glBeginQueryEXT(GL_TIME_ELAPSED_EXT, ptd.activeQuery);
+        sample.query = ptd.activeQuery;
+    }
+
+    sample.cpuBegin = LTime::ns();
+    return sample;
+}
+
+void LScene::LScenePrivate::endViewProfiling(LView *view, const ProfilerSample &sample) noexcept
+{
+    const timespec cpuEnd { LTime::ns() };
+    view->m_renderCost.cpuTimeNs += UInt64(cpuEnd.tv_sec - sample.cpuBegin.tv_sec) * 1000000000 + UInt64(cpuEnd.tv_nsec) - UInt64(sample.cpuBegin.tv_nsec);
+    view->m_renderCost.draws++;
+
+    if (sample.query == 0)
+        return;
+
+    auto &ptd { profilerThreadsMap[std::this_thread::get_id()] };
+    compositor()->imp()->glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+    ptd.activeQuery = 0;
+    ptd.pendingQueries.push_back({ sample.query, LWeak<LView>(view) });
+}
+
+void LScene::LScenePrivate::collectGPURenderCosts() noexcept
+{
+    auto it { profilerThreadsMap.find(std::this_thread::get_id()) };
+
+    if (it == profilerThreadsMap.end() || it->second.pendingQueries.empty())
+        return;
+
+    auto &ptd { it->second };
+    auto &c { *compositor()->imp() };
+
+    // Results are meaningless if something like a GPU frequency change happened in between
+    GLint disjoint { 0 };
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    size_t collected { 0 };
+
+    // Queries complete in order, stop at the first one still in flight
+    for (; collected < ptd.pendingQueries.size(); collected++)
+    {
+        ProfilerQuery &pending { ptd.pendingQueries[collected] };
+        GLuint available { 0 };
+        c.glGetQueryObjectuivEXT(pending.query, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+
+        if (!available)
+            break;
+
+        GLuint64 elapsed { 0 };
+        c.glGetQueryObjectui64vEXT(pending.query, GL_QUERY_RESULT_EXT, &elapsed);
+
+        if (!disjoint && pending.view)
+            pending.view->m_renderCost.gpuTimeNs += elapsed;
+
+        ptd.freeQueries.push_back(pending.query);
+    }
+
+    ptd.pendingQueries.erase(ptd.pendingQueries.begin(), ptd.pendingQueries.begin() + collected);
+}
+
+void LScene::LScenePrivate::destroyProfilerThreadData(std::thread::id thread) noexcept
+{
+    auto it { profilerThreadsMap.find(thread) };
+
+    if (it == profilerThreadsMap.end())
+        return;
+
+    auto &ptd { it->second };
+
+    for (const ProfilerQuery &pending : ptd.pendingQueries)
+        ptd.freeQueries.push_back(pending.query);
+
+    if (!ptd.freeQueries.empty())
+        compositor()->imp()->glDeleteQueriesEXT(ptd.freeQueries.size(), ptd.freeQueries.data());
+
+    profilerThreadsMap.erase(it);
+}
+
+void LScene::LScenePrivate::resetRenderCosts(LView *view) noexcept
+{
+    view->resetRenderCost();
+
+    for (LView *child : view->children())
+        resetRenderCosts(child);
+}
+
+void LScene::LScenePrivate::sumSurfaceRenderCosts(LView *view, std::vector<LScene::SurfaceRenderCost> &costs) noexcept
+{
+    if (view->type() == LView::SurfaceType && view->renderCost().draws > 0)
+    {
+        LSurface *surface { static_cast<LSurfaceView*>(view)->surface() };
+
+        if (surface)
+        {
+            auto it { std::find_if(costs.begin(), costs.end(), [surface](const auto &entry) { return entry.surface == surface; }) };
+
+            if (it == costs.end())
+                costs.push_back({ surface, view->renderCost() });
+            else
+                it->cost += view->renderCost();
+        }
+    }
+
+    for (LView *child : view->children())
+        sumSurfaceRenderCosts(child, costs);
+}
@@ -12,7 +12,10 @@
 #include <LScene.h>
 #include <LBitset.h>
 #include <LSeat.h>
+#include <unordered_map>
+#include <thread>
 #include <mutex>
+#include <ctime>
 
 using namespace Louvre;
 
@@ -40,6 +43,8 @@ LPRIVATE_CLASS(LScene)
         HandlingKeyboardKeyEvent            = static_cast<UInt32>(1) << 17,
         HandlingTouchEvent                  = static_cast<UInt32>(1) << 18,
         AutoRepaint                         = static_cast<UInt32>(1) << 19,
+        AutoScanout                         = static_cast<UInt32>(1) << 20,
+        RenderProfiling                     = static_cast<UInt32>(1) << 21,
     };
 
     LBitset<State> state { AutoRepaint };
@@ -69,6 +74,37 @@ LPRIVATE_CLASS(LScene)
     LPoint viewLocalPos(LView *view, const LPoint &pos);
     bool handlePointerMove(LView *view);
     bool handleTouchDown(LView *view);
+    LRegion visibleRegion(LView *view) noexcept;
+    LView *topmostVisibleView(LView *view, const LRect &rect) noexcept;
+    bool tryAutoScanout(LOutput *output) noexcept;
+
+    // Render profiling (GL queries are per context, so per rendering thread)
+    struct ProfilerQuery
+    {
+        GLuint query;
+        LWeak<LView> view;
+    };
+
+    struct ProfilerThreadData
+    {
+        std::vector<GLuint> freeQueries;
+        std::vector<ProfilerQuery> pendingQueries;
+        GLuint activeQuery { 0 };
+    };
+
+    struct ProfilerSample
+    {
+        GLuint query { 0 };
+        timespec cpuBegin;
+    };
+
+    std::unordered_map<std::thread::id, ProfilerThreadData> profilerThreadsMap;
+    ProfilerSample beginViewProfiling(LPainter *painter) noexcept;
+    void endViewProfiling(LView *view, const ProfilerSample &sample) noexcept;
+    void collectGPURenderCosts() noexcept;
+    void destroyProfilerThreadData(std::thread::id thread) noexcept;
+    void resetRenderCosts(LView *view) noexcept;
+    void sumSurfaceRenderCosts(LView *view, std::vector<LScene::SurfaceRenderCost> &costs) noexcept;
 
     bool pointIsOverView(LView *view, const LPointF &pos, LBitset<LScene::InputFilter> flags)
     {
@@ -1,7 +1,11 @@
 #include <private/LSeatPrivate.h>
 #include <private/LCompositorPrivate.h>
 #include <private/LOutputPrivate.h>
+#include <private/LPointerPrivate.h>
+#include <LPointer.h>
+#include <LCursor.h>
 #include <LLog.h>
+#include <LTime.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstring>
@@ -53,6 +57,8 @@ void LSeat::LSeatPrivate::seatDisabled(libseat *seat, void *data)
     if (compositor()->state() != LCompositor::Initialized)
         return;
 
+    lseat->imp()->flushPendingPointerEvents();
+
     if (compositor()->isInputBackendInitialized())
         compositor()->imp()->inputBackend->backendSuspend();
 
@@ -81,6 +87,169 @@ void LSeat::LSeatPrivate::seatDisabled(libseat *seat, void *data)
     lseat->enabledChanged();
 }
 
+bool LSeat::LSeatPrivate::canCoalescePointerEvents() const noexcept
+{
+    // Pending events are delivered when outputs render, see LCompositorPrivate::requestPointerEventsFlush()
+    return pointerEventCoalescing && enabled && !compositor()->outputs().empty();
+}
+
+void LSeat::LSeatPrivate::repaintForPendingPointerEvents() noexcept
+{
+    if (hasPendingPointerEvents.exchange(true))
+        return;
+
+    // Ensure a frame is going to deliver them
+    if (cursor()->output())
+        cursor()->output()->repaint();
+    else
+        compositor()->repaintAllOutputs();
+}
+
+bool LSeat::LSeatPrivate::coalescePointerMoveEvent(const LPointerMoveEvent &event) noexcept
+{
+    if (!canCoalescePointerEvents())
+        return false;
+
+    if (pendingPointerMove)
+    {
+        pendingPointerMoveEvent.setDelta(pendingPointerMoveEvent.delta() + event.delta());
+        pendingPointerMoveEvent.setDeltaUnaccelerated(pendingPointerMoveEvent.deltaUnaccelerated() + event.deltaUnaccelerated());
+    }
+    else
+    {
+        pendingPointerMove = true;
+        pendingPointerScrollFirst = pendingPointerScroll;
+        pendingPointerMoveEvent.setDelta(event.delta());
+        pendingPointerMoveEvent.setDeltaUnaccelerated(event.deltaUnaccelerated());
+    }
+
+    pendingPointerMoveEvent.setDevice(event.device());
+    pendingPointerMoveEvent.setSerial(event.serial());
+    pendingPointerMoveEvent.setMs(event.ms());
+    pendingPointerMoveEvent.setUs(event.us());
+    repaintForPendingPointerEvents();
+    return true;
+}
+
+bool LSeat::LSeatPrivate::coalescePointerScrollEvent(const LPointerScrollEvent &event) noexcept
+{
+    const LPointF &prevAxes { pendingPointerScroll ? pendingPointerScrollEvent.axes() : lastPointerScrollAxes };
+
+    // Stops are delivered right away, after the pending events
+    if (!canCoalescePointerEvents() || LPointer::LPointerPrivate::isScrollStop(event.axes(), prevAxes))
+    {
+        flushPendingPointerEvents();
+        lastPointerScrollAxes = event.axes();
+        return false;
+    }
+
+    if (pendingPointerScroll && pendingPointerScrollEvent.source() == event.source() && pendingPointerScrollEvent.device() == event.device())
+    {
+        pendingPointerScrollEvent.setAxes(pendingPointerScrollEvent.axes() + event.axes());
+        pendingPointerScrollEvent.setAxes120(pendingPointerScrollEvent.axes120() + event.axes120());
+    }
+    else
+    {
+        if (pendingPointerScroll)
+            deliverPendingPointerEvents();
+
+        pendingPointerScroll = true;
+        pendingPointerScrollFirst = !pendingPointerMove;
+        pendingPointerScrollEvent.setAxes(event.axes());
+        pendingPointerScrollEvent.setAxes120(event.axes120());
+        pendingPointerScrollEvent.setSource(event.source());
+    }
+
+    pendingPointerScrollEvent.setDevice(event.device());
+    pendingPointerScrollEvent.setSerial(event.serial());
+    pendingPointerScrollEvent.setMs(event.ms());
+    pendingPointerScrollEvent.setUs(event.us());
+    repaintForPendingPointerEvents();
+    return true;
+}
+
+void LSeat::LSeatPrivate::deliverPendingPointerEvents() noexcept
+{
+    hasPendingPointerEvents = false;
+
+    const auto deliverScroll = [this]()
+    {
+        if (!pendingPointerScroll)
+            return;
+
+        pendingPointerScroll = false;
+        lastPointerScrollAxes = pendingPointerScrollEvent.axes();
+        seat()->onEvent(pendingPointerScrollEvent);
+        tracePointerLatency(pendingPointerScrollEvent);
+        seat()->pointer()->pointerScrollEvent(pendingPointerScrollEvent);
+    };
+
+    // Interleaved moves and scrolls are merged separately, the first one queued is delivered first
+    if (pendingPointerScrollFirst)
+        deliverScroll();
+
+    if (pendingPointerMove)
+    {
+        pendingPointerMove = false;
+        seat()->onEvent(pendingPointerMoveEvent);
+        tracePointerLatency(pendingPointerMoveEvent);
+        seat()->pointer()->pointerMoveEvent(pendingPointerMoveEvent);
+    }
+
+    deliverScroll();
+}
+
+void LSeat::LSeatPrivate::tracePointerLatencyHandler(const LInputEvent &event) noexcept
+{
+    // Event timestamps are truncated to 32 bits, same as LTime::us()
+    const UInt32 now { LTime::us() };
+    pointerLatency[HandlerLatency].add(now - UInt32(event.us()));
+
+    // Keep the oldest event not flushed yet
+    if (!pendingLatencyFlush)
+    {
+        pendingLatencyFlush = true;
+        latencyFlushInputUs = event.us();
+    }
+}
+
+void LSeat::LSeatPrivate::tracePointerLatencyFlush() noexcept
+{
+    if (!pendingLatencyFlush)
+        return;
+
+    pendingLatencyFlush = false;
+    pointerLatency[FlushLatency].add(LTime::us() - latencyFlushInputUs);
+
+    if (!pendingLatencyPageFlip && cursor() && cursor()->output())
+    {
+        pendingLatencyPageFlip = true;
+        latencyPageFlipInputUs = latencyFlushInputUs;
+        latencyPageFlipOutput.reset(cursor()->output());
+        latencyPageFlipFrame = cursor()->output()->imp()->frame;
+    }
+}
+
+void LSeat::LSeatPrivate::tracePointerLatencyPageFlip(LOutput *output) noexcept
+{
+    if (!pendingLatencyPageFlip)
+        return;
+
+    if (!latencyPageFlipOutput)
+    {
+        pendingLatencyPageFlip = false;
+        return;
+    }
+
+    if (latencyPageFlipOutput != output || output->imp()->frame == latencyPageFlipFrame)
+        return;
+
+    pendingLatencyPageFlip = false;
+    const timespec &time { output->imp()->presentationTime.time };
+    const UInt32 flipUs { UInt32(UInt64(time.tv_sec) * 1000000 + UInt64(time.tv_nsec) / 1000) };
+    pointerLatency[PageFlipLatency].add(flipUs - latencyPageFlipInputUs);
+}
+
 void LSeat::LSeatPrivate::dispatchSeat()
 {
     if (libseatHandle)
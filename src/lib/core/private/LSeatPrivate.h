@@ -3,6 +3,12 @@
 
 #include <LSeat.h>
 #include <LDND.h>
+#include <LPointerMoveEvent.h>
+#include <LPointerScrollEvent.h>
+#include <LLatencyHistogram.h>
+#include <LWeak.h>
+#include <array>
+#include <atomic>
 
 #ifdef  __cplusplus
 extern "C" {
@@ -32,6 +38,44 @@ LPRIVATE_CLASS(LSeat)
     libseat_seat_listener listener;
     bool enabled                            { false };
 
+    // Pointer event coalescing
+    bool pointerEventCoalescing             { false };
+    bool pendingPointerMove                 { false };
+    bool pendingPointerScroll               { false };
+    bool pendingPointerScrollFirst          { false };
+    std::atomic<bool> hasPendingPointerEvents { false };
+    LPointerMoveEvent pendingPointerMoveEvent;
+    LPointerScrollEvent pendingPointerScrollEvent;
+    LPointF lastPointerScrollAxes;
+    bool canCoalescePointerEvents() const noexcept;
+    bool coalescePointerMoveEvent(const LPointerMoveEvent &event) noexcept;
+    bool coalescePointerScrollEvent(const LPointerScrollEvent &event) noexcept;
+    void deliverPendingPointerEvents() noexcept;
+    void repaintForPendingPointerEvents() noexcept;
+    void flushPendingPointerEvents() noexcept
+    {
+        if (pendingPointerMove || pendingPointerScroll)
+            deliverPendingPointerEvents();
+    }
+
+    // Pointer latency tracing
+    bool pointerLatencyTracing              { false };
+    bool pendingLatencyFlush                { false };
+    bool pendingLatencyPageFlip             { false };
+    UInt32 latencyFlushInputUs              { 0 };
+    UInt32 latencyPageFlipInputUs           { 0 };
+    UInt64 latencyPageFlipFrame             { 0 };
+    LWeak<LOutput> latencyPageFlipOutput;
+    std::array<LLatencyHistogram, 3> pointerLatency;
+    void tracePointerLatency(const LInputEvent &event) noexcept
+    {
+        if (pointerLatencyTracing)
+            tracePointerLatencyHandler(event);
+    }
+    void tracePointerLatencyHandler(const LInputEvent &event) noexcept;
+    void tracePointerLatencyFlush() noexcept;
+    void tracePointerLatencyPageFlip(LOutput *output) noexcept;
+
     bool initLibseat();
     static void seatEnabled(libseat *seat, void *data);
     static void seatDisabled(libseat *seat, void *data);
@@ -3,6 +3,8 @@
 #include <protocols/SinglePixelBuffer/LSinglePixelBuffer.h>
 #include <protocols/FractionalScale/RFractionalScale.h>
 #include <protocols/LinuxDMABuf/LDMABuffer.h>
+#include <protocols/LinuxDMABuf/RLinuxDMABufFeedback.h>
+#include <protocols/Wayland/RCallback.h>
 #include <protocols/Wayland/RSurface.h>
 #include <protocols/Wayland/GOutput.h>
 #include <private/LCompositorPrivate.h>
@@ -10,10 +12,27 @@
 #include <private/LTexturePrivate.h>
 #include <private/LOutputPrivate.h>
 #include <private/LKeyboardPrivate.h>
+#include <LSubsurfaceRole.h>
 #include <LOutputMode.h>
 #include <LClient.h>
 #include <LTime.h>
 #include <LLog.h>
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+
+// Available since Linux 6.0
+#ifndef DMA_BUF_IOCTL_EXPORT_SYNC_FILE
+struct dma_buf_export_sync_file
+{
+    __u32 flags;
+    __s32 fd;
+};
+#define DMA_BUF_IOCTL_EXPORT_SYNC_FILE _IOWR(DMA_BUF_BASE, 2, struct dma_buf_export_sync_file)
+#endif
 
 void LSurface::LSurfacePrivate::setParent(LSurface *parent)
 {
@@ -205,9 +224,52 @@ void LSurface::LSurfacePrivate::applyPendingChildren()
             child->imp()->pending.role->handleParentChange();
     }
 
-    compositor()->imp()->surfaceRaiseAllowedCounter++;
-    surface->orderChanged();
-    compositor()->imp()->surfaceRaiseAllowedCounter--;
+    compositor()->imp()->queueOrderChange(surface, true);
+}
+
+LSurface::LSurfacePrivate::WLDRMBuffer *LSurface::LSurfacePrivate::WLDRMBuffer::get(wl_resource *buffer) noexcept
+{
+    wl_listener *listener { wl_resource_get_destroy_listener(buffer, &WLDRMBuffer::onDestroy) };
+
+    return (WLDRMBuffer *)listener;
+}
+
+LSurface::LSurfacePrivate::WLDRMBuffer *LSurface::LSurfacePrivate::WLDRMBuffer::import(wl_resource *buffer) noexcept
+{
+    auto *drmBuffer { new WLDRMBuffer() };
+    compositor()->imp()->eglQueryWaylandBufferWL(LCompositor::eglDisplay(), buffer, EGL_WIDTH, &drmBuffer->widthB);
+    compositor()->imp()->eglQueryWaylandBufferWL(LCompositor::eglDisplay(), buffer, EGL_HEIGHT, &drmBuffer->heightB);
+    drmBuffer->texture = new LTexture(true);
+
+    if (!drmBuffer->texture->setDataFromWaylandDRM(buffer))
+    {
+        delete drmBuffer->texture;
+        delete drmBuffer;
+        return nullptr;
+    }
+
+    drmBuffer->onDestroyListener.notify = &WLDRMBuffer::onDestroy;
+    wl_resource_add_destroy_listener(buffer, &drmBuffer->onDestroyListener);
+    return drmBuffer;
+}
+
+void LSurface::LSurfacePrivate::WLDRMBuffer::onDestroy(wl_listener *listener, void */*data*/) noexcept
+{
+    WLDRMBuffer *drmBuffer { (WLDRMBuffer *)listener };
+
+    // Surfaces still displaying the texture delete it once they get a new buffer
+    for (LSurface *s : compositor()->surfaces())
+    {
+        if (s->texture() == drmBuffer->texture)
+        {
+            drmBuffer->texture->m_pendingDelete = true;
+            delete drmBuffer;
+            return;
+        }
+    }
+
+    delete drmBuffer->texture;
+    delete drmBuffer;
 }
 
 bool LSurface::LSurfacePrivate::bufferToTexture() noexcept
@@ -386,12 +448,12 @@ bool LSurface::LSurfacePrivate::bufferToTexture() noexcept
             else
             {
                 wl_shm_buffer_end_access(shm_buffer);
-                wl_client_flush(wl_resource_get_client(current.bufferRes));
+                compositor()->imp()->flushClientsLater();
                 return true;
             }
 
             wl_shm_buffer_end_access(shm_buffer);
-            wl_client_flush(wl_resource_get_client(current.bufferRes));
+            compositor()->imp()->flushClientsLater();
         }
 
         // WL_DRM
@@ -400,16 +462,29 @@ bool LSurface::LSurfacePrivate::bufferToTexture() noexcept
             /* Unlike SHM buffers, the current buffer is released after
              * a different buffer is commited */
 
-            if (texture && texture != textureBackup && texture->m_pendingDelete)
-                delete texture;
+            WLDRMBuffer *drmBuffer { WLDRMBuffer::get(current.bufferRes) };
 
-            texture = textureBackup;
-            compositor()->imp()->eglQueryWaylandBufferWL(LCompositor::eglDisplay(), current.bufferRes, EGL_WIDTH, &widthB);
-            compositor()->imp()->eglQueryWaylandBufferWL(LCompositor::eglDisplay(), current.bufferRes, EGL_HEIGHT, &heightB);
-            if (!updateDimensions(widthB, heightB))
+            if (!drmBuffer)
+                drmBuffer = WLDRMBuffer::import(current.bufferRes);
+
+            if (!drmBuffer)
+            {
+                LLog::error("[LSurfacePrivate::bufferToTexture] Failed to import wl_drm buffer.");
+                return false;
+            }
+
+            if (!updateDimensions(drmBuffer->widthB, drmBuffer->heightB))
                 return false;
+
             updateDamage();
-            texture->setDataFromWaylandDRM(current.bufferRes);
+
+            if (texture && texture != textureBackup && texture != drmBuffer->texture && texture->m_pendingDelete)
+                delete texture;
+
+            texture = drmBuffer->texture;
+
+            // Same GPU buffer with new content
+            texture->invalidateMipmaps();
         }
 
         // DMA-Buf
@@ -437,6 +512,9 @@ bool LSurface::LSurfacePrivate::bufferToTexture() noexcept
                 delete texture;
 
             texture = dmaBuffer->texture();
+
+            // Same GPU buffer with new content
+            texture->invalidateMipmaps();
         }
         // Single pixel buffer
         else if (LSinglePixelBuffer::isSinglePixelBuffer(current.bufferRes))
@@ -553,6 +631,17 @@ void LSurface::LSurfacePrivate::sendPresentationFeedback(LOutput *output) noexce
     }
 }
 
+void LSurface::LSurfacePrivate::setScanoutFeedback(bool enabled) noexcept
+{
+    if (stateFlags.check(ScanoutFeedback) == enabled)
+        return;
+
+    stateFlags.setFlag(ScanoutFeedback, enabled);
+
+    for (auto *feedback : dmaBufFeedbackResources)
+        feedback->sendFeedback(enabled);
+}
+
 void LSurface::LSurfacePrivate::sendPreferredScale() noexcept
 {
     if (outputs.empty())
@@ -942,3 +1031,177 @@ LSurface *LSurface::LSurfacePrivate::prevSurfaceInLayers() noexcept
 
     return nullptr;
 }
+
+void LSurface::LSurfacePrivate::sendHiddenFrame() noexcept
+{
+    // Commits that reached this point were never displayed
+    for (std::size_t i = 0; i < presentationFeedbackResources.size();)
+    {
+        auto *feedback { presentationFeedbackResources[i] };
+
+        // Not committed yet or waiting for a page flip
+        if (feedback->m_commitId == -1 || feedback->m_outputSet)
+        {
+            i++;
+            continue;
+        }
+
+        feedback->discarded();
+        feedback->m_surface.reset();
+        presentationFeedbackResources[i] = std::move(presentationFeedbackResources.back());
+        presentationFeedbackResources.pop_back();
+        wl_resource_destroy(feedback->resource());
+    }
+
+    // Keep the damage, it still has to be rendered once the surface is displayed
+    surfaceResource->surface()->requestNextFrame(false);
+}
+
+// Returns a fd that becomes readable once the GPU work writing to the DMA buffer is done or -1
+static Int32 exportDMABufFence(Int32 dmaFd) noexcept
+{
+    dma_buf_export_sync_file req {};
+    req.flags = DMA_BUF_SYNC_READ;
+
+    if (ioctl(dmaFd, DMA_BUF_IOCTL_EXPORT_SYNC_FILE, &req) == 0)
+        return req.fd;
+
+    // Polling the DMA buffer itself waits for the same fences
+    if (errno == ENOTTY || errno == EINVAL)
+        return fcntl(dmaFd, F_DUPFD_CLOEXEC, 0);
+
+    return -1;
+}
+
+static bool isFenceSignaled(Int32 fence) noexcept
+{
+    pollfd pfd { fence, POLLIN, 0 };
+    return poll(&pfd, 1, 0) != 0;
+}
+
+bool LSurface::LSurfacePrivate::deferCommit() noexcept
+{
+    if (!compositor()->imp()->dmaBufCommitQueueEnabled
+        || !stateFlags.check(BufferAttached)
+        || !pending.bufferRes
+        || !LDMABuffer::isDMABuffer(pending.bufferRes))
+        return false;
+
+    LSurface *surface { surfaceResource->surface() };
+
+    // Synced subsurfaces are applied along with their parent
+    if (surface->subsurface() && surface->subsurface()->isSynced())
+        return false;
+
+    // A commit arriving while another one waits means the logger didn't run, never reorder them
+    if (deferredCommit)
+        applyDeferredCommit();
+
+    const LDMAPlanes *planes { static_cast<LDMABuffer*>(wl_resource_get_user_data(pending.bufferRes))->planes() };
+    std::vector<Int32> fences;
+
+    for (UInt32 i = 0; i < planes->num_fds; i++)
+    {
+        // Planes usually share the same fd
+        bool duplicated { false };
+
+        for (UInt32 j = 0; j < i; j++)
+            if (planes->fds[j] == planes->fds[i])
+                duplicated = true;
+
+        if (duplicated)
+            continue;
+
+        const Int32 fence { exportDMABufFence(planes->fds[i]) };
+
+        if (fence < 0)
+            continue;
+
+        if (isFenceSignaled(fence))
+            close(fence);
+        else
+            fences.push_back(fence);
+    }
+
+    if (fences.empty())
+        return false;
+
+    deferredCommit = std::make_unique<DeferredCommit>();
+
+    for (Int32 fence : fences)
+    {
+        deferredCommit->fences.push_back(fence);
+        deferredCommit->sources.push_back(LCompositor::addFdListener(fence, this, &onDeferredCommitFence));
+    }
+
+    auto &compositorImp { *compositor()->imp() };
+    compositorImp.deferredCommitSurfaces.push_back(surface);
+
+    if (!compositorImp.deferredCommitsLogger)
+        compositorImp.deferredCommitsLogger = wl_display_add_protocol_logger(LCompositor::display(),
+                                                                             &LCompositor::LCompositorPrivate::onDeferredCommitsLog,
+                                                                             nullptr);
+    return true;
+}
+
+void LSurface::LSurfacePrivate::applyDeferredCommit() noexcept
+{
+    if (!deferredCommit)
+        return;
+
+    cancelDeferredCommit();
+    Wayland::RSurface::apply_commit(surfaceResource->surface());
+}
+
+void LSurface::LSurfacePrivate::cancelDeferredCommit() noexcept
+{
+    if (!deferredCommit)
+        return;
+
+    for (wl_event_source *source : deferredCommit->sources)
+        LCompositor::removeFdListener(source);
+
+    for (Int32 fence : deferredCommit->fences)
+        close(fence);
+
+    deferredCommit.reset();
+
+    // Keep the commit order of the remaining ones
+    auto &surfaces { compositor()->imp()->deferredCommitSurfaces };
+    const auto it { std::find(surfaces.begin(), surfaces.end(), surfaceResource->surface()) };
+
+    if (it != surfaces.end())
+        surfaces.erase(it);
+}
+
+int LSurface::LSurfacePrivate::onDeferredCommitFence(Int32 fd, UInt32 /*mask*/, void *data)
+{
+    auto &imp { *static_cast<LSurfacePrivate*>(data) };
+
+    if (!imp.deferredCommit)
+        return 0;
+
+    auto &deferred { *imp.deferredCommit };
+
+    for (std::size_t i = 0; i < deferred.fences.size(); i++)
+    {
+        if (deferred.fences[i] != fd)
+            continue;
+
+        LCompositor::removeFdListener(deferred.sources[i]);
+        close(fd);
+        deferred.fences.erase(deferred.fences.begin() + i);
+        deferred.sources.erase(deferred.sources.begin() + i);
+        break;
+    }
+
+    if (deferred.fences.empty())
+        imp.applyDeferredCommit();
+
+    return 0;
+}
+
+bool LSurface::LSurfacePrivate::hasCommittedFrameCallbacks() const noexcept
+{
+    return !frameCallbacks.empty() && frameCallbacks.front()->m_commited;
+}
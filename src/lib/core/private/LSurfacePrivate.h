@@ -55,6 +55,9 @@ LPRIVATE_CLASS(LSurface)
         VSync                       = static_cast<UInt16>(1) << 10,
         ChildrenListChanged         = static_cast<UInt16>(1) << 11,
         ParentCommitNotified        = static_cast<UInt16>(1) << 12,
+        ScanoutFeedback             = static_cast<UInt16>(1) << 13,
+        OrderChangePending          = static_cast<UInt16>(1) << 14,
+        OrderChangeForced           = static_cast<UInt16>(1) << 15,
     };
 
     LBitset<StateFlags> stateFlags
@@ -118,20 +121,66 @@ LPRIVATE_CLASS(LSurface)
     std::vector<Wayland::RCallback*>frameCallbacks;
     UInt32 damageId;
     UInt32 commitId { 0 };
+    UInt32 lastFrameCallbackMs { 0 };
     std::list<LSurface*>::iterator compositorLink;
+
+    // See LCompositorPrivate::updateOrderKey() and notifyOrderChanges()
+    UInt64 orderKey { 0 };
+    LWeak<LSurface> notifiedPrevSurface;
     std::list<LSurface*>::iterator layerLink;
     LSurfaceLayer layer { LLayerMiddle };
     Int32 lastSentPreferredBufferScale      { -1 };
     LTransform lastSentPreferredTransform { LTransform::Normal };
     std::vector<LOutput*> outputs;
 
+    /* Texture imported from a wl_drm buffer, kept alive until the buffer is destroyed
+     * so clients rotating through a swapchain are imported only once per buffer */
+    struct WLDRMBuffer
+    {
+        // Must be the first member, the listener is also used as lookup key
+        wl_listener onDestroyListener;
+        LTexture *texture { nullptr };
+        Int32 widthB { 0 };
+        Int32 heightB { 0 };
+
+        // Returns the cached buffer or nullptr if not yet imported
+        static WLDRMBuffer *get(wl_resource *buffer) noexcept;
+        static WLDRMBuffer *import(wl_resource *buffer) noexcept;
+        static void onDestroy(wl_listener *listener, void *data) noexcept;
+    };
+
     std::vector<PresentationTime::RPresentationFeedback*> presentationFeedbackResources;
     std::vector<Protocols::IdleInhibit::RIdleInhibitor*> idleInhibitorResources;
+    std::vector<Protocols::LinuxDMABuf::RLinuxDMABufFeedback*> dmaBufFeedbackResources;
 
     // Find the prev surface using layers (returns nullptr if no prev surface)
     LSurface *prevSurfaceInLayers() noexcept;
     void setLayer(LSurfaceLayer layer);
     void sendPresentationFeedback(LOutput *output) noexcept;
+
+    // Releases the frame callbacks of a surface not being displayed, see LCompositor::setHiddenSurfacesFrameRate()
+    void sendHiddenFrame() noexcept;
+    bool hasCommittedFrameCallbacks() const noexcept;
+
+    /* DMA buffer commit waiting for the client GPU work, see LCompositor::enableDMABufCommitQueue().
+     * Each fence is a sync file exported from a plane, or a dup of the plane fd on kernels without
+     * DMA_BUF_IOCTL_EXPORT_SYNC_FILE, both become readable once the client rendering is done */
+    struct DeferredCommit
+    {
+        std::vector<Int32> fences;
+        std::vector<wl_event_source*> sources;
+    };
+
+    std::unique_ptr<DeferredCommit> deferredCommit;
+
+    // Returns true if the commit must wait for the pending DMA buffer fences
+    bool deferCommit() noexcept;
+    void applyDeferredCommit() noexcept;
+    void cancelDeferredCommit() noexcept;
+    static int onDeferredCommitFence(Int32 fd, UInt32 mask, void *data);
+
+    // Re-sends the linux-dmabuf surface feedback if the scanout candidate state changes
+    void setScanoutFeedback(bool enabled) noexcept;
     void setPendingParent(LSurface *pendParent) noexcept;
     void setParent(LSurface *parent);
     void removeChild(LSurface *child);
@@ -147,7 +196,7 @@ LPRIVATE_CLASS(LSurface)
     void setKeyboardGrabToParent();
     void updateDamage() noexcept;
     bool updateDimensions(Int32 widthB, Int32 heightB) noexcept;
-    void simplifyDamage(std::vector<LRect> &vec) noexcept;
+    static void simplifyDamage(std::vector<LRect> &vec) noexcept;
 };
 
 #endif // LSURFACEPRIVATE_H
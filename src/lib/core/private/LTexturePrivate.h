@@ -4,6 +4,8 @@
 #include <GL/gl.h>
 #include <LTexture.h>
 #include <LSize.h>
+#include <bit>
+#include <cstring>
 
 using namespace Louvre;
 
@@ -30,6 +32,27 @@ public:
         glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
         glPixelStorei(GL_PACK_SKIP_ROWS, 0);
     }
+
+    // Converts 8 bits per channel RGBA pixels to BGRA or vice versa in place
+    inline static void swapRedBlue(UChar8 *pixels, size_t pixelsCount) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            UInt32 pixel;
+
+            for (size_t i = 0; i < pixelsCount; i++)
+            {
+                std::memcpy(&pixel, &pixels[i * 4], sizeof(pixel));
+                pixel = (pixel & 0xFF00FF00) | ((pixel & 0x000000FF) << 16) | ((pixel & 0x00FF0000) >> 16);
+                std::memcpy(&pixels[i * 4], &pixel, sizeof(pixel));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < pixelsCount * 4; i += 4)
+                std::swap(pixels[i], pixels[i + 2]);
+        }
+    }
 };
 
 #endif // LTEXTUREPRIVATE_H
@@ -0,0 +1,268 @@
+#include <private/LPainterPrivate.h>
+#include <LBlurView.h>
+#include <LPainter.h>
+#include <LUtils.h>
+#include <cmath>
+
+using namespace Louvre;
+
+void LBlurView::setRadius(Float32 radius) noexcept
+{
+    if (radius < 1.f)
+        radius = 1.f;
+
+    if (m_radius == radius)
+        return;
+
+    m_radius = radius;
+    invalidateThreadData();
+    markAsChangedOrder(false);
+    repaint();
+}
+
+bool LBlurView::nativeMapped() const noexcept
+{
+    return true;
+}
+
+const LPoint &LBlurView::nativePos() const noexcept
+{
+    return m_nativePos;
+}
+
+const LSize &LBlurView::nativeSize() const noexcept
+{
+    return m_nativeSize;
+}
+
+Float32 LBlurView::bufferScale() const noexcept
+{
+    return 1.f;
+}
+
+void LBlurView::enteredOutput(LOutput *output) noexcept
+{
+    LVectorPushBackIfNonexistent(m_outputs, output);
+}
+
+void LBlurView::leftOutput(LOutput *output) noexcept
+{
+    LVectorRemoveOneUnordered(m_outputs, output);
+}
+
+const std::vector<LOutput *> &LBlurView::outputs() const noexcept
+{
+    return m_outputs;
+}
+
+void LBlurView::requestNextFrame(LOutput *output) noexcept
+{
+    L_UNUSED(output);
+}
+
+const LRegion *LBlurView::damage() const noexcept
+{
+    // Changes behind the view are handled by the scene, see calcRecomputeRegion()
+    return &LRegion::EmptyRegion();
+}
+
+const LRegion *LBlurView::translucentRegion() const noexcept
+{
+    return nullptr;
+}
+
+const LRegion *LBlurView::opaqueRegion() const noexcept
+{
+    return &LRegion::EmptyRegion();
+}
+
+const LRegion *LBlurView::inputRegion() const noexcept
+{
+    return m_inputRegion.get();
+}
+
+void LBlurView::paintEvent(const PaintEventParams &params) noexcept
+{
+    // Also skips the opaque pass, where the content behind is not drawn yet
+    if (params.region->empty())
+        return;
+
+    LPainter *painter { params.painter };
+    LFramebuffer *fb { painter->boundFramebuffer() };
+    ThreadData &td { m_threadsData[std::this_thread::get_id()] };
+
+    if (!td.recompute.empty() && !updateCache(painter, fb, td))
+        return;
+
+    if (!td.valid)
+        return;
+
+    painter->bindTextureMode({
+        .texture = td.cache->texture(),
+        .pos = td.rect.pos(),
+        .srcRect = LRectF(LPointF(), td.rect.size()),
+        .dstSize = td.rect.size(),
+        .srcTransform = LTransform::Normal,
+        .srcScale = td.scale,
+    });
+
+    painter->enableCustomTextureColor(false);
+    painter->drawRegion(*params.region);
+}
+
+Float32 LBlurView::blurScale(Float32 fbScale) const noexcept
+{
+    using P = LPainter::LPainterPrivate;
+
+    // Large radii are computed at a lower resolution to keep the kernel size bounded
+    const Float32 radiusB { m_radius * fbScale };
+
+    if (radiusB <= P::MaxBlurRadiusB)
+        return fbScale;
+
+    return fbScale * P::MaxBlurRadiusB / radiusB;
+}
+
+void LBlurView::calcRecomputeRegion(LFramebuffer *fb, const LRegion &damageBelow, LRegion &redraw) noexcept
+{
+    ThreadData &td { m_threadsData[std::this_thread::get_id()] };
+    const Int32 radius { Int32(ceilf(m_radius)) };
+    const Float32 scale { blurScale(fb->scale()) };
+
+    LRegion visible { m_cache.translucent };
+    visible.clip(fb->rect());
+
+    // Pending work from a frame where the view wasn't painted means the content behind is no longer available
+    if (!td.valid || !td.recompute.empty() || td.rect != m_cache.rect || td.scale != scale)
+        td.recompute = visible;
+    else
+    {
+        // Damage behind the view affects the blurred pixels within the radius
+        td.recompute = damageBelow;
+        td.recompute.clip(m_cache.rect.x() - radius, m_cache.rect.y() - radius, m_cache.rect.w() + 2 * radius, m_cache.rect.h() + 2 * radius);
+        td.recompute.expand(radius);
+        td.recompute.simplifyToExtents(8);
+        td.recompute.intersectRegion(visible);
+    }
+
+    // The pixels around the recomputed area must contain the content behind, so they are redrawn as well
+    redraw = td.recompute;
+    redraw.expand(radius);
+    redraw.clip(fb->rect());
+}
+
+void LBlurView::invalidateThreadData() noexcept
+{
+    for (auto &pair : m_threadsData)
+    {
+        pair.second.valid = false;
+        pair.second.recompute.clear();
+    }
+}
+
+bool LBlurView::updateCache(LPainter *painter, LFramebuffer *fb, ThreadData &td) noexcept
+{
+    LTexture *fbTexture { fb->texture(fb->currentBufferIndex()) };
+
+    if (!fbTexture)
+    {
+        td.recompute.clear();
+        td.valid = false;
+        return false;
+    }
+
+    const Int32 radius { Int32(ceilf(m_radius)) };
+    td.scale = blurScale(fb->scale());
+    td.rect = m_cache.rect;
+
+    const LSize cacheSizeB { Int32(ceilf(Float32(td.rect.w()) * td.scale)), Int32(ceilf(Float32(td.rect.h()) * td.scale)) };
+
+    if (!td.cache)
+        td.cache = std::make_unique<LRenderBuffer>(cacheSizeB);
+    else
+        td.cache->setSizeB(cacheSizeB);
+
+    td.cache->setScale(td.scale);
+    td.cache->setPos(td.rect.pos());
+
+    // Area of the content behind needed to compute the changed pixels
+    const LBox &ext { td.recompute.extents() };
+    const LBox fbBox { fb->rect().x(), fb->rect().y(), fb->rect().x() + fb->rect().w(), fb->rect().y() + fb->rect().h() };
+    const LBox inputBox {
+        std::max(ext.x1 - radius, fbBox.x1),
+        std::max(ext.y1 - radius, fbBox.y1),
+        std::min(ext.x2 + radius, fbBox.x2),
+        std::min(ext.y2 + radius, fbBox.y2) };
+    const LRect inputRect { inputBox.x1, inputBox.y1, inputBox.x2 - inputBox.x1, inputBox.y2 - inputBox.y1 };
+    const LSize inputSizeB { Int32(ceilf(Float32(inputRect.w()) * td.scale)), Int32(ceilf(Float32(inputRect.h()) * td.scale)) };
+
+    for (auto *buffer : { &td.input, &td.tmp })
+    {
+        if (!*buffer)
+            *buffer = std::make_unique<LRenderBuffer>(inputSizeB);
+        else
+            (*buffer)->setSizeB(inputSizeB);
+
+        (*buffer)->setScale(td.scale);
+        (*buffer)->setPos(inputRect.pos());
+    }
+
+    auto &p { *painter->imp() };
+    const Float32 prevAlpha { p.userState.alpha };
+    const LRGBAF prevColorFactor { p.userState.colorFactor };
+    painter->setAlpha(1.f);
+    painter->setColorFactor(1.f, 1.f, 1.f, 1.f);
+    painter->enableCustomTextureColor(false);
+    glDisable(GL_BLEND);
+
+    // Copy the content behind, downscaled if the radius is large
+    const LSize &fbTextureSizeB { fbTexture->sizeB() };
+    const Float32 fbTextureScale { Float32(Louvre::is90Transform(fb->transform()) ? fbTextureSizeB.h() : fbTextureSizeB.w()) / Float32(fb->rect().w()) };
+    painter->bindFramebuffer(td.input.get());
+    painter->bindTextureMode({
+        .texture = fbTexture,
+        .pos = fb->rect().pos(),
+        .srcRect = LRectF(LPointF(), fb->rect().size()),
+        .dstSize = fb->rect().size(),
+        .srcTransform = fb->transform(),
+        .srcScale = fbTextureScale,
+    });
+    painter->drawRect(inputRect);
+
+    // Horizontal pass
+    p.setBlurKernel(m_radius * td.scale);
+    painter->bindFramebuffer(td.tmp.get());
+    painter->bindTextureMode({
+        .texture = td.input->texture(),
+        .pos = inputRect.pos(),
+        .srcRect = LRectF(LPointF(), inputRect.size()),
+        .dstSize = inputRect.size(),
+        .srcTransform = LTransform::Normal,
+        .srcScale = td.scale,
+    });
+    p.shaderSetBlur(true, LPointF(1.f / Float32(td.input->sizeB().w()), 0.f));
+    painter->drawRect(inputRect);
+
+    // Vertical pass, only the changed pixels are replaced in the cache
+    painter->bindFramebuffer(td.cache.get());
+    painter->bindTextureMode({
+        .texture = td.tmp->texture(),
+        .pos = inputRect.pos(),
+        .srcRect = LRectF(LPointF(), inputRect.size()),
+        .dstSize = inputRect.size(),
+        .srcTransform = LTransform::Normal,
+        .srcScale = td.scale,
+    });
+    p.shaderSetBlur(true, LPointF(0.f, 1.f / Float32(td.tmp->sizeB().h())));
+    painter->drawRegion(td.recompute);
+    p.shaderSetBlur(false);
+
+    glEnable(GL_BLEND);
+    painter->bindFramebuffer(fb);
+    painter->setAlpha(prevAlpha);
+    painter->setColorFactor(prevColorFactor);
+
+    td.recompute.clear();
+    td.valid = true;
+    return true;
+}
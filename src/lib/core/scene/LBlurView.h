@@ -0,0 +1,171 @@
+#ifndef LBLURVIEW_H
+#define LBLURVIEW_H
+
+#include <LView.h>
+#include <LRenderBuffer.h>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+
+/**
+ * @brief View that blurs the content behind it.
+ *
+ * This view displays a gaussian blurred copy of the views stacked behind it, which is useful for translucent panels,
+ * docks or menus. It can be combined with a translucent LSolidColorView placed above it to tint the result.
+ *
+ * The blur is computed with a separable kernel in two GPU passes and cached per output. In following frames only the areas
+ * affected by damage of the views behind it (expanded by the blur radius) are recomputed. Damage caused by views above it only
+ * requires redrawing the cached result. To have the pixels around the recomputed areas available, the scene redraws
+ * them too, so very large radii increase the repainted area. Within that area, opaque views stacked above are drawn after
+ * the blur view instead of in the opaque pass, so they never bleed into the blurred content.
+ *
+ * Radii larger than a few dozens of buffer pixels are computed at a lower resolution and then upscaled,
+ * which keeps the cost of each pass bounded.
+ *
+ * @note The content behind is read from the framebuffer texture. If the graphic backend doesn't support accessing
+ *       output textures (see LOutput::bufferTexture()), the view is not displayed.
+ */
+class Louvre::LBlurView : public LView
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param radius The blur radius in surface coordinates.
+     * @param parent The parent view.
+     */
+    LBlurView(Float32 radius = 16.f, LView *parent = nullptr) noexcept :
+        LView(LView::BlurType, true, parent),
+        m_radius(radius < 1.f ? 1.f : radius)
+    {}
+
+    LCLASS_NO_COPY(LBlurView)
+
+    /**
+     * @brief Destructor.
+     */
+    ~LBlurView() noexcept = default;
+
+    /**
+     * @brief Sets the blur radius in surface coordinates.
+     *
+     * Values are clamped to a minimum of 1. Changing it recomputes the entire blur.
+     */
+    void setRadius(Float32 radius) noexcept;
+
+    /**
+     * @brief Blur radius in surface coordinates.
+     */
+    Float32 radius() const noexcept
+    {
+        return m_radius;
+    }
+
+    /**
+     * @brief Set the position of the view.
+     */
+    void setPos(const LPoint &pos) noexcept
+    {
+        setPos(pos.x(), pos.y());
+    }
+
+    /**
+     * @brief Set the position of the view using individual X and Y coordinates.
+     */
+    void setPos(Int32 x, Int32 y) noexcept
+    {
+        if (x == m_nativePos.x() && y == m_nativePos.y())
+            return;
+
+        m_nativePos.setX(x);
+        m_nativePos.setY(y);
+
+        if (!repaintCalled() && mapped())
+            repaint();
+    }
+
+    /**
+     * @brief Set the size of the view.
+     */
+    void setSize(const LSize &size) noexcept
+    {
+        setSize(size.w(), size.h());
+    }
+
+    /**
+     * @brief Set the size of the view using width and height values.
+     */
+    void setSize(Int32 w, Int32 h) noexcept
+    {
+        if (w != m_nativeSize.w() || h != m_nativeSize.h())
+        {
+            m_nativeSize.setW(w);
+            m_nativeSize.setH(h);
+
+            if (!repaintCalled() && mapped())
+                repaint();
+        }
+    }
+
+    /**
+     * @brief Set the input region of the view.
+     *
+     * @param region The new input region or `nullptr` to make the entire view receive input.
+     */
+    void setInputRegion(const LRegion *region) noexcept
+    {
+        if (region)
+        {
+            if (m_inputRegion)
+                *m_inputRegion = *region;
+            else
+                m_inputRegion = std::make_unique<LRegion>(*region);
+        }
+        else
+            m_inputRegion.reset();
+    }
+
+    virtual bool nativeMapped() const noexcept override;
+    virtual const LPoint &nativePos() const noexcept override;
+    virtual const LSize &nativeSize() const noexcept override;
+    virtual Float32 bufferScale() const noexcept override;
+    virtual void enteredOutput(LOutput *output) noexcept override;
+    virtual void leftOutput(LOutput *output) noexcept override;
+    virtual const std::vector<LOutput*> &outputs() const noexcept override;
+    virtual void requestNextFrame(LOutput *output) noexcept override;
+    virtual const LRegion *damage() const noexcept override;
+    virtual const LRegion *translucentRegion() const noexcept override;
+    virtual const LRegion *opaqueRegion() const noexcept override;
+    virtual const LRegion *inputRegion() const noexcept override;
+    virtual void paintEvent(const PaintEventParams &params) noexcept override;
+
+protected:
+    friend class LView;
+    friend class LSceneView;
+
+    // Blurred content cached for each rendering thread
+    struct ThreadData
+    {
+        std::unique_ptr<LRenderBuffer> cache;
+        std::unique_ptr<LRenderBuffer> input;
+        std::unique_ptr<LRenderBuffer> tmp;
+        LRegion recompute;
+        LRect rect;
+        Float32 scale { 0.f };
+        bool valid { false };
+    };
+
+    std::vector<LOutput *> m_outputs;
+    std::unique_ptr<LRegion> m_inputRegion;
+    std::unordered_map<std::thread::id, ThreadData> m_threadsData;
+    LPoint m_nativePos;
+    LSize m_nativeSize;
+    Float32 m_radius { 0.f };
+
+    Float32 blurScale(Float32 fbScale) const noexcept;
+    void calcRecomputeRegion(LFramebuffer *fb, const LRegion &damageBelow, LRegion &redraw) noexcept;
+    void invalidateThreadData() noexcept;
+    bool updateCache(LPainter *painter, LFramebuffer *fb, ThreadData &td) noexcept;
+};
+
+#endif // LBLURVIEW_H
@@ -42,6 +42,74 @@ bool LScene::autoRepaintEnabled() const noexcept
     return imp()->state.check(LSS::AutoRepaint);
 }
 
+void LScene::enableAutoScanout(bool enabled) noexcept
+{
+    imp()->state.setFlag(LSS::AutoScanout, enabled);
+}
+
+bool LScene::autoScanoutEnabled() const noexcept
+{
+    return imp()->state.check(LSS::AutoScanout);
+}
+
+void LScene::enableRenderProfiling(bool enabled) noexcept
+{
+    imp()->state.setFlag(LSS::RenderProfiling, enabled);
+}
+
+bool LScene::renderProfilingEnabled() const noexcept
+{
+    return imp()->state.check(LSS::RenderProfiling);
+}
+
+void LScene::resetRenderCosts() noexcept
+{
+    imp()->mutex.lock();
+    imp()->resetRenderCosts(mainView());
+    imp()->mutex.unlock();
+}
+
+static UInt64 renderCostKey(const LView::RenderCost &cost) noexcept
+{
+    return cost.gpuTimeNs > 0 ? cost.gpuTimeNs : cost.cpuTimeNs;
+}
+
+std::vector<LScene::SurfaceRenderCost> LScene::surfaceRenderCosts() noexcept
+{
+    std::vector<SurfaceRenderCost> costs;
+    imp()->mutex.lock();
+    imp()->sumSurfaceRenderCosts(mainView(), costs);
+    imp()->mutex.unlock();
+
+    std::sort(costs.begin(), costs.end(), [](const auto &a, const auto &b) {
+        return renderCostKey(a.cost) > renderCostKey(b.cost);
+    });
+
+    return costs;
+}
+
+std::vector<LScene::ClientRenderCost> LScene::clientRenderCosts() noexcept
+{
+    std::vector<ClientRenderCost> costs;
+
+    for (const SurfaceRenderCost &surfaceCost : surfaceRenderCosts())
+    {
+        LClient *client { surfaceCost.surface->client() };
+        auto it { std::find_if(costs.begin(), costs.end(), [client](const auto &entry) { return entry.client == client; }) };
+
+        if (it == costs.end())
+            costs.push_back({ client, surfaceCost.cost });
+        else
+            it->cost += surfaceCost.cost;
+    }
+
+    std::sort(costs.begin(), costs.end(), [](const auto &a, const auto &b) {
+        return renderCostKey(a.cost) > renderCostKey(b.cost);
+    });
+
+    return costs;
+}
+
 const std::vector<LView *> &LScene::pointerFocus() const
 {
     return imp()->pointerFocus;
@@ -82,7 +150,11 @@ void LScene::handlePaintGL(LOutput *output)
 
     imp()->mutex.lock();
     imp()->view.m_fb = output->framebuffer();
-    imp()->view.render();
+    imp()->collectGPURenderCosts();
+
+    if (!imp()->state.check(LSS::AutoScanout) || !imp()->tryAutoScanout(output))
+        imp()->view.render();
+
     imp()->mutex.unlock();
 }
 
@@ -117,6 +189,7 @@ void LScene::handleUninitializeGL(LOutput *output)
     auto it { imp()->view.m_sceneThreadsMap.find(output->threadId()) };
     if (it != imp()->view.m_sceneThreadsMap.end())
         imp()->view.m_sceneThreadsMap.erase(it);
+    imp()->destroyProfilerThreadData(output->threadId());
     imp()->mutex.unlock();
 }
 
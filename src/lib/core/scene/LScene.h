@@ -152,6 +152,97 @@ public:
      */
     bool autoRepaintEnabled() const noexcept;
 
+    /**
+     * @brief Enables or disables automatic direct scanout.
+     *
+     * When enabled, handlePaintGL() checks if the topmost visible content of the output is a single opaque, unscaled and untransformed
+     * LSurfaceView with a DMA or `wl_drm` buffer covering the entire output. If so, the buffer is passed to LOutput::setCustomScanoutBuffer()
+     * instead of rendering the scene, which removes GPU composition entirely (e.g. for fullscreen videos or games).\n
+     * The scene is rendered as usual as soon as the condition breaks, for example if the cursor must be composited, a screenshot is requested,
+     * or another view is displayed on top.
+     *
+     * Disabled by default.
+     */
+    void enableAutoScanout(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if automatic direct scanout is enabled.
+     *
+     * @see enableAutoScanout()
+     */
+    bool autoScanoutEnabled() const noexcept;
+
+    /**
+     * @brief Enables or disables render profiling.
+     *
+     * When enabled, each paintEvent() of the views in the scene is wrapped with CPU timers and, if the
+     * output's GL context supports `GL_EXT_disjoint_timer_query`, with GPU timer queries.
+     * The costs are accumulated in LView::renderCost() and can be aggregated per surface and client with
+     * surfaceRenderCosts() and clientRenderCosts(), for example to display them in a debug overlay.
+     *
+     * Profiling adds some overhead to each draw, so it is intended for debugging purposes only.
+     *
+     * Disabled by default.
+     */
+    void enableRenderProfiling(bool enabled) noexcept;
+
+    /**
+     * @brief Checks if render profiling is enabled.
+     *
+     * @see enableRenderProfiling()
+     */
+    bool renderProfilingEnabled() const noexcept;
+
+    /**
+     * @brief Resets the render cost of all the views in the scene.
+     *
+     * @see LView::resetRenderCost()
+     *
+     * @note Locks the scene while rendering, so it must not be called from a view's paintEvent().
+     */
+    void resetRenderCosts() noexcept;
+
+    /**
+     * @brief Render cost of a surface.
+     */
+    struct SurfaceRenderCost
+    {
+        /// The surface
+        LSurface *surface;
+
+        /// Sum of the costs of all the LSurfaceViews displaying the surface
+        LView::RenderCost cost;
+    };
+
+    /**
+     * @brief Render cost of a client.
+     */
+    struct ClientRenderCost
+    {
+        /// The client
+        LClient *client;
+
+        /// Sum of the costs of all the LSurfaceViews displaying surfaces of the client
+        LView::RenderCost cost;
+    };
+
+    /**
+     * @brief Render costs accumulated by the surface views of the scene, aggregated per surface.
+     *
+     * Sorted from the most to the least expensive, using the GPU time if available and the CPU time otherwise.
+     * Surfaces without draws since the last resetRenderCosts() are not included.
+     *
+     * @note Locks the scene while rendering, so it must not be called from a view's paintEvent().
+     */
+    std::vector<SurfaceRenderCost> surfaceRenderCosts() noexcept;
+
+    /**
+     * @brief Render costs accumulated by the surface views of the scene, aggregated per client.
+     *
+     * Sorted like surfaceRenderCosts().
+     */
+    std::vector<ClientRenderCost> clientRenderCosts() noexcept;
+
     /**
      * @brief Vector of views with pointer focus.
      *
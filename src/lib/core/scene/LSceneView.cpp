@@ -1,6 +1,8 @@
 #include <private/LCompositorPrivate.h>
 #include <private/LPainterPrivate.h>
+#include <private/LScenePrivate.h>
 #include <LSurfaceView.h>
+#include <LBlurView.h>
 #include <LSceneView.h>
 #include <LScene.h>
 #include <LUtils.h>
@@ -80,6 +82,39 @@ void LSceneView::render(const LRegion *exclude) noexcept
         ctd.o = painter->imp()->output;
     }
 
+    calcDamage(ctd, exclude);
+
+    glDisable(GL_BLEND);
+
+    for (std::list<LView*>::const_reverse_iterator it = children().crbegin(); it != children().crend(); it++)
+        drawOpaqueDamage(*it);
+
+    drawBackground(!isLScene() && m_clearColor.a >= 1.f);
+
+    glEnable(GL_BLEND);
+
+    for (std::list<LView*>::const_iterator it = children().cbegin(); it != children().cend(); it++)
+        drawTranslucentDamage(*it);
+
+    if (!isLScene())
+    {
+        if (!ctd.newDamage.empty())
+            m_fb->texture(m_fb->currentBufferIndex())->invalidateMipmaps();
+
+        ctd.opaqueSum.clip(m_fb->rect());
+        ctd.translucentSum = ctd.opaqueSum;
+        ctd.translucentSum.inverse(m_fb->rect());
+    }
+    else
+    {
+        m_fb->setFramebufferDamage(&ctd.newDamage);
+    }
+
+    painter->bindFramebuffer(prevFb);
+}
+
+void LSceneView::calcDamage(ThreadData &ctd, const LRegion *exclude) noexcept
+{
     clearTmpVariables(ctd);
     checkRectChange(ctd);
 
@@ -107,9 +142,19 @@ void LSceneView::render(const LRegion *exclude) noexcept
         }
     }
 
+    // Damage added before this point is treated as coming from behind all blur views
+    LRegion externalDamage { std::move(ctd.newDamage) };
+    ctd.blurSegments.clear();
+    ctd.blurInput.clear();
+
     for (std::list<LView*>::const_reverse_iterator it = children().crbegin(); it != children().crend(); it++)
         calcNewDamage(*it);
 
+    ctd.newDamage.addRegion(externalDamage);
+
+    if (!ctd.blurSegments.empty())
+        updateBlurDamage();
+
     // Save new damage for next frame and add old damage to current damage
     if (m_fb->buffersCount() > 1)
     {
@@ -128,31 +173,6 @@ void LSceneView::render(const LRegion *exclude) noexcept
         ctd.prevDamageList.pop_front();
         ctd.prevDamageList.push_back(front);
     }
-
-    glDisable(GL_BLEND);
-
-    for (std::list<LView*>::const_reverse_iterator it = children().crbegin(); it != children().crend(); it++)
-        drawOpaqueDamage(*it);
-
-    drawBackground(!isLScene() && m_clearColor.a >= 1.f);
-
-    glEnable(GL_BLEND);
-
-    for (std::list<LView*>::const_iterator it = children().cbegin(); it != children().cend(); it++)
-        drawTranslucentDamage(*it);
-
-    if (!isLScene())
-    {
-        ctd.opaqueSum.clip(m_fb->rect());
-        ctd.translucentSum = ctd.opaqueSum;
-        ctd.translucentSum.inverse(m_fb->rect());
-    }
-    else
-    {
-        m_fb->setFramebufferDamage(&ctd.newDamage);
-    }
-
-    painter->bindFramebuffer(prevFb);
 }
 
 bool LSceneView::nativeMapped() const noexcept
@@ -234,6 +254,7 @@ void LSceneView::paintEvent(const PaintEventParams &params) noexcept
         .dstSize = size(),
         .srcTransform = m_fb->transform(),
         .srcScale = bufferScale(),
+        .mipmapFiltering = mipmapFilteringEnabled(),
     });
 
     params.painter->enableCustomTextureColor(false);
@@ -249,7 +270,8 @@ void LSceneView::calcNewDamage(LView *view) noexcept
     {
         LSceneView &sceneView { static_cast<LSceneView&>(*view) };
 
-        if (view->m_cache.scalingEnabled)
+        // Excluding the opaque region above would invalidate the cached content each time it is uncovered
+        if (view->m_cache.scalingEnabled || sceneView.m_cacheAsTexture)
             sceneView.render(nullptr);
         else
             sceneView.render(&ctd.opaqueSum);
@@ -260,6 +282,10 @@ void LSceneView::calcNewDamage(LView *view) noexcept
             calcNewDamage(*it);
     }
 
+    // Views are visited from top to bottom, so the damage accumulated so far comes from views above the blur view
+    if (view->type() == BlurType)
+        ctd.blurSegments.push_back({ static_cast<LBlurView*>(view), std::move(ctd.newDamage) });
+
     // Quick view cache handle to reduce verbosity
     LView::ViewCache &cache { view->m_cache };
 
@@ -273,21 +299,20 @@ void LSceneView::calcNewDamage(LView *view) noexcept
     cache.scalingVector = view->scalingVector();
     cache.scalingEnabled = (view->scalingEnabled() || view->parentScalingEnabled()) && cache.scalingVector != LSizeF(1.f, 1.f);
 
-    LRegion vRegion {cache.rect};
+    LRect vRect { cache.rect };
 
     if (view->clippingEnabled())
-        vRegion.clip(view->clippingRect());
+        vRect.clip(view->clippingRect());
 
     if (view->parent() && view->parentClippingEnabled())
-        vRegion.clip(view->parent()->pos(), view->parent()->size());
+        vRect.clip(LRect(view->parent()->pos(), view->parent()->size()));
 
     // Update view intersected outputs
     for (LOutput *o : compositor()->outputs())
     {
-        LRegion r { vRegion };
-        r.clip(o->rect());
+        LRect r { vRect };
 
-        if (!r.empty())
+        if (!r.clip(o->rect()))
             view->enteredOutput(o);
         else
             view->leftOutput(o);
@@ -395,24 +420,21 @@ void LSceneView::calcNewDamage(LView *view) noexcept
     if (view->clippingEnabled())
         currentClipping.clip(view->clippingRect());
 
-    // Calculates the new exposed view region if parent clipping or clipped region has grown
-
-    /* LRegion newExposedClipping = currentClipping;
-     * newExposedClipping.subtractRegion(cache.voD->prevClipping);*/
-
-    LRegion newExposedClipping;
-    pixman_region32_subtract(&newExposedClipping.m_region,
-                             &currentClipping.m_region,
-                             &cache.voD->prevClipping.m_region);
-
-    cache.damage.addRegion(newExposedClipping);
+    // Nothing is exposed or hidden if the clipping didn't change (the common case)
+    if (!(currentClipping == cache.voD->prevClipping))
+    {
+        // Calculates the new exposed view region if parent clipping or clipped region has grown
+        ctd.newExposedClipping = currentClipping;
+        ctd.newExposedClipping.subtractRegion(cache.voD->prevClipping);
+        cache.damage.addRegion(ctd.newExposedClipping);
 
-    // Add exposed now non clipped region to new output damage
-    cache.voD->prevClipping.subtractRegion(currentClipping);
-    ctd.newDamage.addRegion(cache.voD->prevClipping);
+        // Add exposed now non clipped region to new output damage
+        cache.voD->prevClipping.subtractRegion(currentClipping);
+        ctd.newDamage.addRegion(cache.voD->prevClipping);
 
-    // Saves current clipped region for next frame
-    cache.voD->prevClipping = currentClipping;
+        // Saves current clipped region for next frame
+        cache.voD->prevClipping = currentClipping;
+    }
 
     // Clip current damage to current visible region
     cache.damage.intersectRegion(currentClipping);
@@ -464,10 +486,8 @@ void LSceneView::calcNewDamage(LView *view) noexcept
     cache.opaque.intersectRegion(currentClipping);
     cache.translucent.intersectRegion(currentClipping);
 
-    // Check if view is ocludded
-    currentClipping.subtractRegion(ctd.opaqueSum);
-
-    cache.occluded = currentClipping.empty();
+    // Check if view is ocludded (the clipping is a single box)
+    cache.occluded = currentClipping.empty() || ctd.opaqueSum.containsBox(currentClipping.extents());
 
     if (ctd.o && (!cache.occluded || view->forceRequestNextFrameEnabled()))
         view->requestNextFrame(ctd.o);
@@ -504,7 +524,85 @@ void LSceneView::drawOpaqueDamage(LView *view) noexcept
     ctd.p->setAlpha(1.f);
     m_paintParams.painter = ctd.p;
     m_paintParams.region = &cache.opaque;
+    paintView(view);
+}
+
+void LSceneView::updateBlurDamage() noexcept
+{
+    auto &ctd { *m_currentThreadData };
+    LRegion redraw;
+
+    // From bottom to top, ctd.newDamage contains the damage behind each blur view
+    for (auto it = ctd.blurSegments.rbegin(); it != ctd.blurSegments.rend(); it++)
+    {
+        LBlurView *blurView { it->view };
+
+        if (blurView->m_cache.mapped && !blurView->m_cache.occluded)
+        {
+            blurView->calcRecomputeRegion(m_fb, ctd.newDamage, redraw);
+            ctd.newDamage.addRegion(redraw);
+            ctd.blurInput.addRegion(redraw);
+        }
+        else
+        {
+            blurView->invalidateThreadData();
+        }
+
+        ctd.newDamage.addRegion(it->damageAbove);
+    }
+
+    ctd.blurSegments.clear();
+
+    if (ctd.blurInput.empty())
+        return;
+
+    for (std::list<LView*>::const_reverse_iterator it = children().crbegin(); it != children().crend(); it++)
+        revealBlurInput(*it);
+}
+
+void LSceneView::revealBlurInput(LView *view) noexcept
+{
+    auto &ctd { *m_currentThreadData };
+
+    if (view->type() != SceneType)
+        for (std::list<LView*>::const_reverse_iterator it = view->children().crbegin(); it != view->children().crend(); it++)
+            revealBlurInput(*it);
+
+    LView::ViewCache &cache { view->m_cache };
+
+    if (!view->isRenderable() || !cache.mapped)
+        return;
+
+    /* Blur views copy the framebuffer during the translucent pass, so opaque views above them must not be drawn in
+     * the opaque pass there, and views behind them must not be culled. Within that area all views are drawn from
+     * bottom to top in the translucent pass instead */
+    ctd.newExposedClipping = cache.opaque;
+    ctd.newExposedClipping.intersectRegion(ctd.blurInput);
+    cache.translucent.addRegion(ctd.newExposedClipping);
+    cache.opaque.subtractRegion(ctd.blurInput);
+    cache.opaqueOverlay.subtractRegion(ctd.blurInput);
+
+    if (!cache.occluded)
+        return;
+
+    const LRegion &clipping { cache.voD->prevClipping };
+    cache.occluded = clipping.empty() || cache.opaqueOverlay.containsBox(clipping.extents());
+
+    if (ctd.o && !cache.occluded)
+        view->requestNextFrame(ctd.o);
+}
+
+void LSceneView::paintView(LView *view) noexcept
+{
+    if (!scene() || !scene()->renderProfilingEnabled())
+    {
+        view->paintEvent(m_paintParams);
+        return;
+    }
+
+    const auto sample { scene()->imp()->beginViewProfiling(m_paintParams.painter) };
     view->paintEvent(m_paintParams);
+    scene()->imp()->endViewProfiling(view, sample);
 }
 
 void LSceneView::drawTranslucentDamage(LView *view) noexcept
@@ -532,7 +630,7 @@ void LSceneView::drawTranslucentDamage(LView *view) noexcept
     ctd.p->setAlpha(cache.opacity);
     m_paintParams.painter = ctd.p;
     m_paintParams.region = &cache.translucent;
-    view->paintEvent(m_paintParams);
+    paintView(view);
 
 drawChildrenOnly:
     if (view->type() != SceneType)
@@ -76,6 +76,40 @@ public:
             repaint();
     }
 
+    /**
+     * @brief Keeps the whole content of a nested scene view cached in its framebuffer.
+     *
+     * By default, a nested scene view doesn't render the areas covered by opaque views above it in the parent scene,
+     * so those parts of its children are rendered again each time they are uncovered, for example while a window moves over it.\n
+     * When enabled, the full content is kept in the framebuffer, children are only re-rendered where they are damaged themselves
+     * and the parent scene draws the cached texture. Useful for mostly static subtrees made of many views, such as panels or docks.
+     *
+     * Disabled by default. Has no effect on the main view of an LScene.
+     *
+     * @param enabled `true` to enable, `false` to disable.
+     */
+    void enableCacheAsTexture(bool enabled) noexcept
+    {
+        if (m_cacheAsTexture == enabled)
+            return;
+
+        m_cacheAsTexture = enabled;
+
+        // The previously excluded area is damaged on the next render()
+        if (!repaintCalled() && mapped())
+            repaint();
+    }
+
+    /**
+     * @brief Checks if the content is cached as a texture.
+     *
+     * @see enableCacheAsTexture()
+     */
+    bool cacheAsTextureEnabled() const noexcept
+    {
+        return m_cacheAsTexture;
+    }
+
     /**
      * @brief Apply damage to all areas of the scene view for a specific output.
      *
@@ -209,6 +243,10 @@ protected:
         LRegion prevExternalExclude;
         LRegion opaqueSum;
         LRegion translucentSum;
+        LRegion newExposedClipping;
+
+        // Area read by blur views this frame, see revealBlurInput()
+        LRegion blurInput;
         LRect prevRect;
         LPainter *p { nullptr };
         LOutput *o { nullptr };
@@ -216,6 +254,14 @@ protected:
         Int32 n, w, h;
         bool oversampling = false;
         bool fractionalScale = false;
+
+        // Damage of the views above each blur view, see updateBlurDamage()
+        struct BlurSegment
+        {
+            LBlurView *view;
+            LRegion damageAbove;
+        };
+        std::vector<BlurSegment> blurSegments;
     };
 
     std::unordered_map<std::thread::id, ThreadData> m_sceneThreadsMap;
@@ -225,18 +271,26 @@ protected:
     LPoint m_customPos;
     std::vector<LOutput*> m_outputs;
     PaintEventParams m_paintParams;
+    bool m_cacheAsTexture { false };
 
 private:
     friend class LScene;
     friend class LView;
+    friend class LSceneViewBenchmark;
+    friend class LSceneViewTest;
     LSceneView(LFramebuffer *framebuffer = nullptr, LView *parent = nullptr) noexcept :
         LView(LView::SceneType, true, parent),
         m_fb(framebuffer)
     {}
 
+    // Damage pass of render(), doesn't use the painter
+    void calcDamage(ThreadData &ctd, const LRegion *exclude) noexcept;
     void calcNewDamage(LView *view) noexcept;
     void drawOpaqueDamage(LView *view) noexcept;
     void drawTranslucentDamage(LView *view) noexcept;
+    void paintView(LView *view) noexcept;
+    void updateBlurDamage() noexcept;
+    void revealBlurInput(LView *view) noexcept;
 
     void parentClipping(LView *parent, LRegion *region) noexcept
     {
@@ -256,6 +310,9 @@ private:
         pixman_region32_subtract(&backgroundDamage.m_region,
                                  &ctd.newDamage.m_region,
                                  &ctd.opaqueSum.m_region);
+
+        // Opaque views are drawn in the translucent pass there
+        backgroundDamage.addRegion(ctd.blurInput);
         ctd.p->setColor({.r = m_clearColor.r, .g = m_clearColor.g, .b = m_clearColor.b});
         ctd.p->setAlpha(m_clearColor.a);
         ctd.p->enableAutoBlendFunc(true);
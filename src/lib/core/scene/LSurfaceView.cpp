@@ -172,6 +172,7 @@ void LSurfaceView::paintEvent(const PaintEventParams &params) noexcept
         .dstSize = size(),
         .srcTransform = surface()->bufferTransform(),
         .srcScale = bufferScale(),
+        .mipmapFiltering = mipmapFilteringEnabled(),
     });
 
     params.painter->enableCustomTextureColor(false);
@@ -3,6 +3,7 @@
 #include <LTextureView.h>
 #include <LCompositor.h>
 #include <LUtils.h>
+#include <cmath>
 
 void LTextureView::setInputRegion(const LRegion *region)
 {
@@ -44,6 +45,34 @@ void LTextureView::setTexture(LTexture *texture) noexcept
     damageAll();
 }
 
+void LTextureView::setAtlasEntry(const LTextureAtlas::Entry *entry) noexcept
+{
+    if (!entry)
+    {
+        enableSrcRect(false);
+        enableDstSize(false);
+        setTexture(nullptr);
+        return;
+    }
+
+    // Map the entry from page buffer coords to the surface space expected by setSrcRect()
+    LRegion rect { entry->rectB() };
+    rect.transform(entry->texture()->sizeB(), m_transform);
+    const LBox &box { rect.extents() };
+
+    setSrcRect(LRectF(Float32(box.x1) / m_bufferScale,
+                      Float32(box.y1) / m_bufferScale,
+                      Float32(box.x2 - box.x1) / m_bufferScale,
+                      Float32(box.y2 - box.y1) / m_bufferScale));
+    enableSrcRect(true);
+
+    // Otherwise the view would be sized from the entire page
+    setDstSize(Int32(ceilf(Float32(box.x2 - box.x1) / m_bufferScale)),
+               Int32(ceilf(Float32(box.y2 - box.y1) / m_bufferScale)));
+    enableDstSize(true);
+    setTexture(entry->texture());
+}
+
 bool LTextureView::nativeMapped() const noexcept
 {
     return m_texture != nullptr;
@@ -122,6 +151,7 @@ void LTextureView::paintEvent(const PaintEventParams &params) noexcept
         .dstSize = size(),
         .srcTransform = transform(),
         .srcScale = bufferScale(),
+        .mipmapFiltering = mipmapFilteringEnabled(),
     });
 
     params.painter->enableCustomTextureColor(customColorEnabled());
@@ -3,6 +3,7 @@
 
 #include <LView.h>
 #include <LWeak.h>
+#include <LTextureAtlas.h>
 
 /**
  * @brief View for displaying textures
@@ -129,6 +130,18 @@ public:
      */
     void setTexture(LTexture *texture) noexcept;
 
+    /**
+     * @brief Sets an LTextureAtlas entry as the view's texture.
+     *
+     * Uses the atlas page as the texture and enables a source rect and destination size matching the entry, so views displaying entries
+     * of the same page share a single texture. The entry's buffer rect is mapped through transform() and divided by bufferScale(),
+     * so set both first.\n
+     * Passing `nullptr` unsets the texture and disables the source rect and destination size.
+     *
+     * @param entry The atlas entry to display.
+     */
+    void setAtlasEntry(const LTextureAtlas::Entry *entry) noexcept;
+
     /**
      * @brief Gets the current LTexture used by the LTextureView.
      *
@@ -1,6 +1,7 @@
 #include <private/LCompositorPrivate.h>
 #include <private/LScenePrivate.h>
 #include <LSceneTouchPoint.h>
+#include <LBlurView.h>
 #include <LTouchCancelEvent.h>
 #include <LOutput.h>
 #include <LUtils.h>
@@ -194,6 +195,12 @@ void LView::removeThread(std::thread::id thread)
         m_threadsMap.erase(it);
     }
 
+    if (type() == BlurType)
+    {
+        static_cast<LBlurView*>(this)->m_threadsData.erase(thread);
+        return;
+    }
+
     if (type() != SceneType)
         return;
 
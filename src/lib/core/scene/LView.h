@@ -162,7 +162,10 @@ public:
         SolidColorType,
 
         /// LSceneView
-        SceneType
+        SceneType,
+
+        /// LBlurView
+        BlurType
     };
 
     /**
@@ -810,6 +813,88 @@ public:
         return m_state.check(ForceRequestNextFrame);
     }
 
+    /**
+     * @brief Toggles mipmapped texture filtering.
+     *
+     * When enabled, views that draw textures (LTextureView, LSurfaceView and LSceneView) sample them from a
+     * mipmap chain generated on the GPU whenever they are displayed smaller than their buffer size,
+     * instead of using plain bilinear filtering. This avoids having to keep downscaled copies
+     * made with LTexture::copy() for thumbnails or overview-like effects.
+     *
+     * @note It is ignored for textures imported from client DMA or `wl_drm` buffers, see LTexture::enableMipmaps().
+     *
+     * @see LTexture::enableMipmaps()
+     *
+     * Disabled by default.
+     */
+    void enableMipmapFiltering(bool enabled) noexcept
+    {
+        if (enabled == m_state.check(MipmapFiltering))
+            return;
+
+        m_state.setFlag(MipmapFiltering, enabled);
+        repaint();
+    }
+
+    /**
+     * @brief Checks if mipmapped texture filtering is enabled.
+     *
+     * @see enableMipmapFiltering()
+     */
+    bool mipmapFilteringEnabled() const noexcept
+    {
+        return m_state.check(MipmapFiltering);
+    }
+
+    /**
+     * @brief Rendering cost of a view.
+     *
+     * Accumulated while render profiling is enabled, see LScene::enableRenderProfiling().
+     */
+    struct RenderCost
+    {
+        /// CPU time spent in paintEvent() in nanoseconds
+        UInt64 cpuTimeNs { 0 };
+
+        /// GPU time spent executing the commands issued in paintEvent() in nanoseconds, always 0 if `GL_EXT_disjoint_timer_query` is not supported
+        UInt64 gpuTimeNs { 0 };
+
+        /// Number of times paintEvent() was called
+        UInt32 draws { 0 };
+
+        RenderCost &operator+=(const RenderCost &other) noexcept
+        {
+            cpuTimeNs += other.cpuTimeNs;
+            gpuTimeNs += other.gpuTimeNs;
+            draws += other.draws;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Rendering cost accumulated since the last call to resetRenderCost().
+     *
+     * Only updated while render profiling is enabled in the scene the view belongs to, see LScene::enableRenderProfiling().\n
+     * GPU times are collected asynchronously, so they lag a few frames behind the CPU times.
+     *
+     * @note Outputs may be rendered in separate threads, so this should only be read during LOutput::paintGL()
+     *       or through LScene::surfaceRenderCosts() and LScene::clientRenderCosts().
+     */
+    const RenderCost &renderCost() const noexcept
+    {
+        return m_renderCost;
+    }
+
+    /**
+     * @brief Resets renderCost() to zero.
+     *
+     * @see LScene::resetRenderCosts()
+     */
+    void resetRenderCost() noexcept
+    {
+        m_renderCost = RenderCost();
+    }
+
     /**
      * @brief Sets a custom alpha/color blending function for the view.
      *
@@ -1263,6 +1348,9 @@ public:
         CustomInputRegion       = static_cast<UInt64>(1) << 45,
         CustomTranslucentRegion = static_cast<UInt64>(1) << 46,
         AlwaysMapped            = static_cast<UInt64>(1) << 47,
+
+        // LView
+        MipmapFiltering         = static_cast<UInt64>(1) << 48,
     };
 
     // This is used for detecting changes on a view since the last time it was drawn on a specific output
@@ -1301,6 +1389,7 @@ protected:
     friend class LScene;
     friend class LSceneView;
     friend class LCompositor;
+    friend class LSceneViewTest;
     mutable LBitset<LViewState> m_state { Visible | ParentOffset | ParentOpacity | BlockPointer | AutoBlendFunc };
     LScene *m_scene { nullptr };
     LView *m_parent { nullptr };
@@ -1320,6 +1409,7 @@ protected:
     mutable LSize m_tmpSize;
     mutable LSizeF m_tmpSizeF;
     ViewCache m_cache;
+    RenderCost m_renderCost;
     std::map<std::thread::id,ViewThreadData> m_threadsMap;
 
     bool repaintCalled() const noexcept
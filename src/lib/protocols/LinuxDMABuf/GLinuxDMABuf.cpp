@@ -2,6 +2,7 @@
 #include <protocols/LinuxDMABuf/GLinuxDMABuf.h>
 #include <protocols/LinuxDMABuf/RLinuxBufferParams.h>
 #include <protocols/LinuxDMABuf/RLinuxDMABufFeedback.h>
+#include <protocols/Wayland/RSurface.h>
 #include <private/LCompositorPrivate.h>
 #include <private/LClientPrivate.h>
 #include <LUtils.h>
@@ -96,9 +97,11 @@ void GLinuxDMABuf::get_default_feedback(wl_client */*client*/, wl_resource *reso
 {
     new RLinuxDMABufFeedback(static_cast<GLinuxDMABuf*>(wl_resource_get_user_data(resource)), id);
 }
-void GLinuxDMABuf::get_surface_feedback(wl_client */*client*/, wl_resource *resource, UInt32 id, wl_resource */*surface*/)
+void GLinuxDMABuf::get_surface_feedback(wl_client */*client*/, wl_resource *resource, UInt32 id, wl_resource *surface)
 {
-    new RLinuxDMABufFeedback(static_cast<GLinuxDMABuf*>(wl_resource_get_user_data(resource)), id);
+    new RLinuxDMABufFeedback(static_cast<GLinuxDMABuf*>(wl_resource_get_user_data(resource)),
+                             id,
+                             static_cast<Wayland::RSurface*>(wl_resource_get_user_data(surface))->surface());
 }
 #endif
 
@@ -2,6 +2,8 @@
 #include <protocols/LinuxDMABuf/GLinuxDMABuf.h>
 #include <protocols/LinuxDMABuf/RLinuxDMABufFeedback.h>
 #include <private/LCompositorPrivate.h>
+#include <private/LSurfacePrivate.h>
+#include <LUtils.h>
 
 using namespace Louvre::Protocols::LinuxDMABuf;
 
@@ -12,7 +14,8 @@ static const struct zwp_linux_dmabuf_feedback_v1_interface imp
 
 RLinuxDMABufFeedback::RLinuxDMABufFeedback(
     GLinuxDMABuf *linuxDMABufRes,
-    UInt32 id
+    UInt32 id,
+    LSurface *surface
     ) noexcept
     :LResource
     (
@@ -21,7 +24,27 @@ RLinuxDMABufFeedback::RLinuxDMABufFeedback(
         linuxDMABufRes->version(),
         id,
         &imp
-    )
+    ),
+    m_surface(surface)
+{
+    /* Surface feedback only advertises the scanout tranche while the
+     * surface is a direct scanout candidate, see LOutputPrivate::updateScanoutCandidate() */
+    if (surface)
+    {
+        surface->imp()->dmaBufFeedbackResources.push_back(this);
+        sendFeedback(surface->imp()->stateFlags.check(LSurface::LSurfacePrivate::ScanoutFeedback));
+    }
+    else
+        sendFeedback(true);
+}
+
+RLinuxDMABufFeedback::~RLinuxDMABufFeedback() noexcept
+{
+    if (surface())
+        LVectorRemoveOneUnordered(surface()->imp()->dmaBufFeedbackResources, this);
+}
+
+void RLinuxDMABufFeedback::sendFeedback(bool scanout) noexcept
 {
     auto &feedback { compositor()->imp()->dmaFeedback };
 
@@ -36,18 +59,25 @@ RLinuxDMABufFeedback::RLinuxDMABufFeedback(
         mainDevice(&dev);
         formatTable(feedback.tableFd, feedback.tableSize);
 
-        if (!compositor()->imp()->graphicBackend->backendGetScanoutDMAFormats()->empty())
+        if (scanout && !compositor()->imp()->graphicBackend->backendGetScanoutDMAFormats()->empty())
         {
             trancheTargetDevice(&dev);
             trancheFlags(ZWP_LINUX_DMABUF_FEEDBACK_V1_TRANCHE_FLAGS_SCANOUT);
             trancheFormats(&feedback.scanoutIndices);
             trancheDone();
-        }
 
-        trancheTargetDevice(&dev);
-        trancheFlags(0);
-        trancheFormats(&feedback.formatIndices);
-        trancheDone();
+            trancheTargetDevice(&dev);
+            trancheFlags(0);
+            trancheFormats(&feedback.formatIndices);
+            trancheDone();
+        }
+        else
+        {
+            trancheTargetDevice(&dev);
+            trancheFlags(0);
+            trancheFormats(&feedback.allIndices);
+            trancheDone();
+        }
     }
 
     done();
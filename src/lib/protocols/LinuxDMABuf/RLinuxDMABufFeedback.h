@@ -2,11 +2,21 @@
 #define RLINUXDMABUFFEEDBACK_H
 
 #include <LResource.h>
+#include <LWeak.h>
 
 class Louvre::Protocols::LinuxDMABuf::RLinuxDMABufFeedback final : public LResource
 {
 public:
 
+    // nullptr for feedback objects created with get_default_feedback()
+    LSurface *surface() const noexcept
+    {
+        return m_surface;
+    }
+
+    // Sends the main device, format table and tranches followed by done()
+    void sendFeedback(bool scanout) noexcept;
+
     /******************** REQUESTS ********************/
 
     static void destroy(wl_client *, wl_resource *resource) noexcept;
@@ -24,8 +34,9 @@ public:
 
 private:
     friend class Louvre::Protocols::LinuxDMABuf::GLinuxDMABuf;
-    RLinuxDMABufFeedback(GLinuxDMABuf *linuxDMABufRes, UInt32 id) noexcept;
-    ~RLinuxDMABufFeedback() noexcept = default;
+    RLinuxDMABufFeedback(GLinuxDMABuf *linuxDMABufRes, UInt32 id, LSurface *surface = nullptr) noexcept;
+    ~RLinuxDMABufFeedback() noexcept;
+    LWeak<LSurface> m_surface;
 };
 
 #endif // RLINUXDMABUFFEEDBACK_H
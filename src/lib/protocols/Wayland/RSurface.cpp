@@ -12,6 +12,7 @@
 #include <private/LFactory.h>
 #include <LCursorRole.h>
 #include <LDNDIconRole.h>
+#include <LTime.h>
 #include <LLog.h>
 
 using namespace Louvre::Protocols::Wayland;
@@ -84,6 +85,8 @@ RSurface::RSurface
         surface()->imp()->compositorLink = compositor()->imp()->surfaces.begin();
     }
 
+    compositor()->imp()->updateOrderKey(surface());
+    surface()->imp()->notifiedPrevSurface.reset(surface()->prevSurface());
     compositor()->imp()->surfacesListChanged = true;
 }
 
@@ -91,6 +94,9 @@ RSurface::~RSurface()
 {
     LSurface *lSurface { this->surface() };
 
+    // Drop the commit waiting for its buffer fences, if any
+    lSurface->imp()->cancelDeferredCommit();
+
     lSurface->imp()->setKeyboardGrabToParent();
 
     // Notify from client
@@ -203,7 +209,13 @@ void RSurface::destroy(wl_client */*client*/, wl_resource *resource)
 
 void RSurface::commit(wl_client */*client*/, wl_resource *resource)
 {
-    apply_commit(static_cast<const RSurface*>(wl_resource_get_user_data(resource))->surface());
+    LSurface *surface { static_cast<const RSurface*>(wl_resource_get_user_data(resource))->surface() };
+
+    // Applied later if the attached DMA buffer is still being rendered by the client
+    if (surface->imp()->deferCommit())
+        return;
+
+    apply_commit(surface);
 }
 
 static bool bufferIsBeingScannedByOutputs(wl_buffer *buffer) noexcept
@@ -277,7 +289,7 @@ void RSurface::apply_commit(LSurface *surface, LBaseSurfaceRole::CommitOrigin or
                 && imp.current.bufferRes != imp.pending.bufferRes)
             {
                 wl_buffer_send_release(imp.current.bufferRes);
-                wl_client_flush(wl_resource_get_client(imp.current.bufferRes));
+                compositor()->imp()->flushClientsLater();
             }
         }
 
@@ -296,10 +308,15 @@ void RSurface::apply_commit(LSurface *surface, LBaseSurfaceRole::CommitOrigin or
     // Mark the next frame as commited
     if (!imp.frameCallbacks.empty())
     {
+        // Hidden surfaces are throttled relative to when they started waiting
+        if (!imp.hasCommittedFrameCallbacks())
+            imp.lastFrameCallbackMs = LTime::ms();
+
         for (RCallback *callback : imp.frameCallbacks)
             callback->m_commited = true;
 
         surface->requestedRepaint();
+        compositor()->imp()->scheduleHiddenSurfacesFrames();
     }
 
     /*****************************************
@@ -0,0 +1,76 @@
+#ifndef LFRAMESCHEDULER_TEST_H
+#define LFRAMESCHEDULER_TEST_H
+
+#include <LTest.h>
+#include <LFrameScheduler.h>
+
+using namespace Louvre;
+
+void LFrameScheduler_test_01()
+{
+    LSetTestName("LFrameScheduler_test_01");
+    LFrameScheduler s;
+    LAssert("Unknown timing should start immediately", s.schedule(1000, 0, 16667) == 1000 && s.deadline() == 0);
+    LAssert("Without samples it should start immediately", s.schedule(1000, 500, 16667) == 1000 && s.deadline() == 17167);
+    s.framePresented(17200);
+    LAssert("Frame should be on time", s.frames() == 1 && s.missedDeadlines() == 0);
+    s.framePresented(17200);
+    LAssert("Frames without a deadline should not be counted", s.frames() == 1);
+}
+
+void LFrameScheduler_test_02()
+{
+    LSetTestName("LFrameScheduler_test_02");
+    LFrameScheduler s;
+    s.setSafetyMargin(1000);
+    s.addRenderDuration(3000);
+    s.addRenderDuration(2000);
+    LAssert("Prediction should be the max duration", s.predictedRenderDuration() == 3000);
+
+    // Vblank at 10000, 26667, 43334...
+    LAssert("Should start 4 ms before the next vblank", s.schedule(10100, 10000, 16667) == 26667 - 4000);
+    LAssert("Deadline should be the next vblank", s.deadline() == 26667);
+
+    LAssert("Missing vblanks should be extrapolated", s.schedule(30000, 10000, 16667) == 43334 - 4000);
+
+    s.addRenderDuration(20000);
+    LAssert("Durations longer than a period should start immediately", s.schedule(30000, 10000, 16667) == 30000);
+}
+
+void LFrameScheduler_test_03()
+{
+    LSetTestName("LFrameScheduler_test_03");
+
+    // Timer driven virtual output: 60 Hz, constant 2 ms frames and a single 6 ms spike
+    const UInt32 period { 16667 };
+    UInt64 vblank { 100000 };
+    LFrameScheduler s;
+    s.setSafetyMargin(1000);
+    s.addRenderDuration(2000);
+
+    for (UInt32 i = 0; i < 10; i++)
+    {
+        const UInt64 now { vblank + 200 };
+        const UInt64 start { s.schedule(now, vblank, period) };
+        const UInt32 duration { i == 5 ? 6000u : 2000u };
+        vblank += period;
+
+        // Presented at the targeted vblank or at the following one, with some timestamp jitter
+        s.framePresented(start + duration > s.deadline() ? vblank + period + 50 : vblank - 50);
+        s.addRenderDuration(duration);
+    }
+
+    LAssert("Only the spike should miss its deadline", s.frames() == 10 && s.missedDeadlines() == 1);
+    LAssert("Prediction should adapt to the spike", s.predictedRenderDuration() == 6000);
+    s.resetStats();
+    LAssert("Stats should be cleared", s.frames() == 0 && s.missedDeadlines() == 0);
+}
+
+void LFrameScheduler_run_tests()
+{
+    LFrameScheduler_test_01();
+    LFrameScheduler_test_02();
+    LFrameScheduler_test_03();
+}
+
+#endif // LFRAMESCHEDULER_TEST_H
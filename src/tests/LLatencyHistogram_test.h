@@ -0,0 +1,54 @@
+#ifndef LLATENCYHISTOGRAM_TEST_H
+#define LLATENCYHISTOGRAM_TEST_H
+
+#include <LTest.h>
+#include <LLatencyHistogram.h>
+
+using namespace Louvre;
+
+void LLatencyHistogram_test_01()
+{
+    LSetTestName("LLatencyHistogram_test_01");
+    LLatencyHistogram h;
+    LAssert("Empty histogram should have no samples", h.count() == 0 && h.min() == 0 && h.max() == 0 && h.mean() == 0.0);
+    LAssert("Empty histogram percentile should be 0", h.percentile(99.f) == 0);
+}
+
+void LLatencyHistogram_test_02()
+{
+    LSetTestName("LLatencyHistogram_test_02");
+    LAssert("0 and 1 should fall into bucket 0", LLatencyHistogram::bucketIndex(0) == 0 && LLatencyHistogram::bucketIndex(1) == 0);
+    LAssert("2 and 3 should fall into bucket 1", LLatencyHistogram::bucketIndex(2) == 1 && LLatencyHistogram::bucketIndex(3) == 1);
+    LAssert("1000 should fall into bucket 9", LLatencyHistogram::bucketIndex(1000) == 9);
+    LAssert("Huge samples should fall into the last bucket", LLatencyHistogram::bucketIndex(UINT32_MAX) == LLatencyHistogram::BucketCount - 1);
+}
+
+void LLatencyHistogram_test_03()
+{
+    LSetTestName("LLatencyHistogram_test_03");
+    LLatencyHistogram h;
+
+    for (UInt32 i = 0; i < 99; i++)
+        h.add(100);
+
+    h.add(5000);
+
+    LAssert("Count should be 100", h.count() == 100);
+    LAssert("Min should be 100", h.min() == 100);
+    LAssert("Max should be 5000", h.max() == 5000);
+    LAssert("Mean should be 149", h.mean() == 149.0);
+    LAssert("p50 should be the upper bound of the 100 us bucket", h.percentile(50.f) == 128);
+    LAssert("p100 should be clamped to max", h.percentile(100.f) == 5000);
+
+    h.reset();
+    LAssert("Reset histogram should be empty", h.count() == 0 && h.buckets()[LLatencyHistogram::bucketIndex(100)] == 0);
+}
+
+void LLatencyHistogram_run_tests()
+{
+    LLatencyHistogram_test_01();
+    LLatencyHistogram_test_02();
+    LLatencyHistogram_test_03();
+}
+
+#endif // LLATENCYHISTOGRAM_TEST_H
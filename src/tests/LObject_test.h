@@ -29,10 +29,41 @@ void LObject_test_02()
     LAssert("LObject weak data counter should be 0", weakRefs.size() == 0);
 }
 
+void LObject_test_03()
+{
+    LSetTestName("LObject_test_03");
+    LWeak<LObjectTest> weak[8];
+
+    {
+        LObjectTest obj;
+        auto &weakRefs = LWeakUtils::objectRefs(&obj);
+
+        // More refs than the inline ones
+        for (auto &w : weak)
+            w.reset(&obj);
+
+        LAssert("LObject weak refs count should be 8", weakRefs.size() == 8);
+
+        weak[1].reset();
+        weak[6].reset();
+        LAssert("LObject weak refs count should be 6", weakRefs.size() == 6);
+
+        for (UInt32 i = 0; i < weakRefs.size(); i++)
+            LAssert("LObject weak refs should only contain live LWeak references", ((LWeak<LObjectTest>*)weakRefs[i])->get() == &obj);
+
+        weak[1].reset(&obj);
+        LAssert("LObject weak refs count should be 7", weakRefs.size() == 7);
+    }
+
+    for (auto &w : weak)
+        LAssert("LWeak get() should return nullptr", w == nullptr);
+}
+
 void LObject_run_tests()
 {
     LObject_test_01();
     LObject_test_02();
+    LObject_test_03();
 }
 
 #endif // LOBJECT_TEST_H
@@ -0,0 +1,107 @@
+#ifndef LORDERCHANGEFILTER_TEST_H
+#define LORDERCHANGEFILTER_TEST_H
+
+#include <LTest.h>
+#include <private/LOrderChangeFilter.h>
+#include <algorithm>
+#include <vector>
+
+using namespace Louvre;
+
+// Mimics louvre-views, where each surface view is inserted right after the view of its previous surface
+struct LOrderChangeFilterTestSurface
+{
+    const LOrderChangeFilterTestSurface *notifiedPrev { nullptr };
+    bool queued { false };
+};
+
+using LOrderChangeFilterTestList = std::vector<LOrderChangeFilterTestSurface*>;
+
+static void LOrderChangeFilter_test_queue(LOrderChangeFilterTestList &queue, LOrderChangeFilterTestSurface *surface)
+{
+    if (surface && !surface->queued)
+    {
+        surface->queued = true;
+        queue.push_back(surface);
+    }
+}
+
+// Same changes LCompositorPrivate queues when raising a surface
+static void LOrderChangeFilter_test_raise(LOrderChangeFilterTestList &surfaces, LOrderChangeFilterTestList &queue, LOrderChangeFilterTestSurface *surface)
+{
+    auto it { std::find(surfaces.begin(), surfaces.end(), surface) };
+
+    if (it + 1 != surfaces.end())
+        LOrderChangeFilter_test_queue(queue, *(it + 1));
+
+    surfaces.erase(it);
+    surfaces.push_back(surface);
+    LOrderChangeFilter_test_queue(queue, surface);
+}
+
+static void LOrderChangeFilter_test_notify(const LOrderChangeFilterTestList &surfaces, LOrderChangeFilterTestList &views, LOrderChangeFilterTestList &queue)
+{
+    std::sort(queue.begin(), queue.end(), [&surfaces](auto *a, auto *b)
+    {
+        return std::find(surfaces.begin(), surfaces.end(), a) < std::find(surfaces.begin(), surfaces.end(), b);
+    });
+
+    LOrderChangeFilter<LOrderChangeFilterTestSurface> filter;
+
+    for (LOrderChangeFilterTestSurface *surface : queue)
+    {
+        surface->queued = false;
+        auto it { std::find(surfaces.begin(), surfaces.end(), surface) };
+        LOrderChangeFilterTestSurface *prev { it == surfaces.begin() ? nullptr : *(it - 1) };
+
+        if (!filter.shouldNotify(surface, prev, surface->notifiedPrev, false))
+            continue;
+
+        surface->notifiedPrev = prev;
+        views.erase(std::find(views.begin(), views.end(), surface));
+        views.insert(prev ? std::find(views.begin(), views.end(), prev) + 1 : views.begin(), surface);
+    }
+
+    queue.clear();
+}
+
+void LOrderChangeFilter_test_01()
+{
+    LSetTestName("LOrderChangeFilter_test_01");
+
+    LOrderChangeFilterTestSurface s[5];
+    LOrderChangeFilterTestList surfaces, views, queue;
+
+    for (UInt32 i = 0; i < 5; i++)
+    {
+        s[i].notifiedPrev = i == 0 ? nullptr : &s[i - 1];
+        surfaces.push_back(&s[i]);
+    }
+
+    views = surfaces;
+
+    // A B C D E => A C D E B => A D E B C
+    LOrderChangeFilter_test_raise(surfaces, queue, &s[1]);
+    LOrderChangeFilter_test_raise(surfaces, queue, &s[2]);
+    LOrderChangeFilter_test_notify(surfaces, views, queue);
+    LAssert("Two raises in one iteration should keep views in order", views == surfaces);
+
+    const LOrderChangeFilterTestSurface *prevOfB { s[1].notifiedPrev };
+    LOrderChangeFilter<LOrderChangeFilterTestSurface> filter;
+    LAssert("Unchanged surfaces should not be notified", !filter.shouldNotify(&s[1], prevOfB, prevOfB, false));
+    LAssert("Forced changes should always be notified", filter.shouldNotify(&s[1], prevOfB, prevOfB, true));
+
+    // Raise a surface and the one right below it, e.g. a toplevel and its transient
+    LOrderChangeFilter_test_raise(surfaces, queue, &s[0]);
+    LOrderChangeFilter_test_raise(surfaces, queue, &s[3]);
+    LOrderChangeFilter_test_raise(surfaces, queue, &s[4]);
+    LOrderChangeFilter_test_notify(surfaces, views, queue);
+    LAssert("Several raises in one iteration should keep views in order", views == surfaces);
+}
+
+void LOrderChangeFilter_run_tests()
+{
+    LOrderChangeFilter_test_01();
+}
+
+#endif // LORDERCHANGEFILTER_TEST_H
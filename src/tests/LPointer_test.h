@@ -0,0 +1,67 @@
+#ifndef LPOINTER_TEST_H
+#define LPOINTER_TEST_H
+
+#include <LTest.h>
+#include <private/LPointerPrivate.h>
+#include <vector>
+
+using namespace Louvre;
+
+// Merges scroll deltas the same way LSeat pointer event coalescing does, returning the delivered axes
+static std::vector<LPointF> LPointer_test_coalesceScroll(const std::vector<LPointF> &stream)
+{
+    std::vector<LPointF> delivered;
+    LPointF pending, last;
+    bool hasPending { false };
+
+    for (const LPointF &axes : stream)
+    {
+        if (LPointer::LPointerPrivate::isScrollStop(axes, hasPending ? pending : last))
+        {
+            if (hasPending)
+                delivered.push_back(pending);
+
+            delivered.push_back(axes);
+            last = axes;
+            hasPending = false;
+        }
+        else if (hasPending)
+            pending += axes;
+        else
+        {
+            pending = axes;
+            hasPending = true;
+        }
+    }
+
+    if (hasPending)
+        delivered.push_back(pending);
+
+    return delivered;
+}
+
+void LPointer_test_01()
+{
+    LSetTestName("LPointer_test_01");
+
+    const std::vector<LPointF> wheel { { 0.f, 10.f }, { 0.f, 10.f }, { 0.f, 15.f }, { 0.f, 5.f } };
+    std::vector<LPointF> delivered { LPointer_test_coalesceScroll(wheel) };
+    LAssert("Vertical only events should be merged", delivered.size() == 1 && delivered[0] == LPointF(0.f, 40.f));
+
+    const std::vector<LPointF> touchpad { { 0.f, 2.f }, { 0.f, 3.f }, { 0.f, 0.f }, { 0.f, 1.f }, { 0.f, 1.f } };
+    delivered = LPointer_test_coalesceScroll(touchpad);
+    LAssert("Stops should be delivered separately and in order",
+            delivered.size() == 3 && delivered[0] == LPointF(0.f, 5.f) && delivered[1] == LPointF(0.f, 0.f) && delivered[2] == LPointF(0.f, 2.f));
+
+    const std::vector<LPointF> diagonal { { 1.f, 2.f }, { 1.f, 2.f }, { 0.f, 2.f }, { 0.f, 2.f } };
+    delivered = LPointer_test_coalesceScroll(diagonal);
+    LAssert("An axis dropping to zero should not be merged",
+            delivered.size() == 3 && delivered[0] == LPointF(2.f, 4.f) && delivered[1] == LPointF(0.f, 2.f) && delivered[2] == LPointF(0.f, 2.f));
+}
+
+void LPointer_run_tests()
+{
+    LPointer_test_01();
+}
+
+#endif // LPOINTER_TEST_H
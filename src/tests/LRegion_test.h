@@ -61,10 +61,83 @@ void LRegion_test_02()
     LAssert("regionA should contain 1 box", n == 1);
 }
 
+void LRegion_test_03()
+{
+    LSetTestName("LRegion_test_03");
+
+    LRegion region;
+    region.expand(10);
+    LAssert("expanding an empty region should keep it empty", region.empty());
+
+    region.addRect(10, 10, 10, 10);
+    region.expand(5);
+    LAssert("expanded extents should be (5, 5, 25, 25)", region.extents().x1 == 5 && region.extents().y1 == 5 && region.extents().x2 == 25 && region.extents().y2 == 25);
+
+    // Two separated rects that overlap once expanded
+    region.clear();
+    region.addRect(0, 0, 10, 10);
+    region.addRect(14, 0, 10, 10);
+    region.expand(2);
+    LAssert("expanded region should contain the gap", region.containsPoint(LPoint(12, 5)));
+    LAssert("expanded region should not contain distant points", !region.containsPoint(LPoint(12, 20)));
+
+    region.expand(-4);
+    LAssert("negative amounts should be ignored", region.containsPoint(LPoint(-2, -2)));
+}
+
+void LRegion_test_04()
+{
+    LSetTestName("LRegion_test_04");
+
+    LRegion region;
+    region.addRect(0, 0, 10, 10);
+    region.addRect(20, 20, 10, 10);
+    region.clear();
+    LAssert("cleared region should be empty", region.empty());
+
+    Int32 n;
+    region.boxes(&n);
+    LAssert("cleared region should contain 0 boxes", n == 0);
+
+    LRegion twoBoxes;
+    twoBoxes.addRect(0, 0, 10, 10);
+    twoBoxes.addRect(20, 20, 10, 10);
+    const LRegion clipRegion { LRect(5, 5, 20, 20) };
+
+    // Operations with multi-box results should only allocate until the storages are big enough
+    const auto refill = [&]()
+    {
+        region.clear();
+        region.addRegion(twoBoxes);
+        region.subtractRect(0, 0, 5, 5);
+        region.intersectRegion(clipRegion);
+    };
+
+    for (int i = 0; i < 4; i++)
+        refill();
+
+    const UInt64 allocations { LRegion::allocationsCount() };
+
+    for (int i = 0; i < 8; i++)
+        refill();
+
+    LAssert("refilling a region should reuse its storage", LRegion::allocationsCount() == allocations);
+    region.boxes(&n);
+    LAssert("refilled region should contain 2 boxes", n == 2);
+    LAssert("refilled region should contain (7, 7)", region.containsPoint(LPoint(7, 7)));
+    LAssert("refilled region should not contain (27, 27)", !region.containsPoint(LPoint(27, 27)));
+
+    region.transform(LSize(30, 30), LTransform::Flipped);
+    LAssert("flipped region should contain (22, 7)", region.containsPoint(LPoint(22, 7)));
+    LAssert("flipped region should not contain (7, 7)", !region.containsPoint(LPoint(7, 7)));
+}
+
 void LRegion_run_tests()
 {
     LRegion_test_01();
     LRegion_test_02();
+    LRegion_test_03();
+    LRegion_test_04();
 }
 
 #endif // LREGION_TEST_H
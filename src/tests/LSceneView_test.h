@@ -0,0 +1,76 @@
+#ifndef LSCENEVIEW_TEST_H
+#define LSCENEVIEW_TEST_H
+
+#include <LTest.h>
+#include <LSceneView.h>
+#include <LBlurView.h>
+#include <LSolidColorView.h>
+#include <thread>
+
+using namespace Louvre;
+
+namespace Louvre
+{
+    /* Runs the damage pass of LSceneView::render(), which doesn't need a painter */
+    class LSceneViewTest
+    {
+    public:
+        static void calcDamage(LSceneView &scene) noexcept
+        {
+            scene.m_currentThreadData.reset(&scene.m_sceneThreadsMap[std::this_thread::get_id()]);
+            scene.calcDamage(*scene.m_currentThreadData, nullptr);
+        }
+
+        static const LView::ViewCache &cache(const LView &view) noexcept
+        {
+            return view.m_cache;
+        }
+    };
+}
+
+void LSceneView_test_01()
+{
+    LSetTestName("LSceneView_test_01");
+
+    // An opaque icon on a blurred dock, above an opaque wallpaper
+    LSceneView scene(LSize(400, 400), 1.f);
+    LSolidColorView wallpaper(1.f, 0.f, 0.f, 1.f, &scene);
+    wallpaper.setSize(400, 400);
+    LBlurView dock(8.f, &scene);
+    dock.setPos(0, 300);
+    dock.setSize(400, 100);
+    LSolidColorView icon(0.f, 0.f, 1.f, 1.f, &scene);
+    icon.setPos(50, 320);
+    icon.setSize(40, 40);
+
+    LSceneViewTest::calcDamage(scene);
+
+    const LRegion iconRegion { LRect(50, 320, 40, 40) };
+    const auto &iconCache { LSceneViewTest::cache(icon) };
+    const auto &wallpaperCache { LSceneViewTest::cache(wallpaper) };
+
+    LAssert("The icon should not be drawn before the blur input is copied", iconCache.opaque.empty());
+    LAssert("The icon should be drawn after the blur view", iconCache.translucent == iconRegion);
+
+    LRegion hidden { wallpaperCache.opaqueOverlay };
+    hidden.intersectRegion(iconRegion);
+    LAssert("The wallpaper should be drawn behind the icon", hidden.empty() && !wallpaperCache.occluded);
+
+    LRegion wallpaperOpaque { wallpaperCache.opaque };
+    wallpaperOpaque.intersectRegion(LRect(0, 300, 400, 100));
+    LAssert("The wallpaper should be drawn from bottom to top behind the dock", wallpaperOpaque.empty());
+
+    // Views outside the blur input keep using the opaque pass
+    LSolidColorView window(0.f, 1.f, 0.f, 1.f, &scene);
+    window.setPos(0, 0);
+    window.setSize(200, 100);
+    LSceneViewTest::calcDamage(scene);
+    LAssert("Views far from blur views should stay opaque", LSceneViewTest::cache(window).opaque == LRegion(LRect(0, 0, 200, 100)));
+}
+
+void LSceneView_run_tests()
+{
+    LSceneView_test_01();
+}
+
+#endif // LSCENEVIEW_TEST_H
@@ -0,0 +1,111 @@
+#ifndef LTEXTUREATLAS_TEST_H
+#define LTEXTUREATLAS_TEST_H
+
+#include <LTest.h>
+#include <LTextureAtlas.h>
+
+using namespace Louvre;
+
+namespace Louvre
+{
+    /* Exercises the shelf allocator with pages without textures, which don't need a painter */
+    class LTextureAtlasTest
+    {
+    public:
+        static UInt32 addPage(LTextureAtlas &atlas) noexcept
+        {
+            atlas.m_pages.emplace_back();
+            return atlas.m_pages.size() - 1;
+        }
+
+        static bool allocate(LTextureAtlas &atlas, UInt32 pageIndex, const LSize &paddedSizeB, LPoint *pos) noexcept
+        {
+            return atlas.allocate(atlas.m_pages[pageIndex], paddedSizeB, pos);
+        }
+
+        static LTextureAtlas::Entry *addEntry(LTextureAtlas &atlas, UInt32 pageIndex, const LSize &paddedSizeB) noexcept
+        {
+            LPoint pos;
+
+            if (!allocate(atlas, pageIndex, paddedSizeB, &pos))
+                return nullptr;
+
+            return atlas.createEntry(pageIndex, LRect(pos, LSize(paddedSizeB.w() - atlas.m_padding, paddedSizeB.h() - atlas.m_padding)));
+        }
+
+        static UInt32 shelvesCount(const LTextureAtlas &atlas, UInt32 pageIndex) noexcept
+        {
+            return atlas.m_pages[pageIndex].shelves.size();
+        }
+
+        static bool needsClear(const LTextureAtlas &atlas, UInt32 pageIndex) noexcept
+        {
+            return atlas.m_pages[pageIndex].needsClear;
+        }
+    };
+}
+
+void LTextureAtlas_test_01()
+{
+    LSetTestName("LTextureAtlas_test_01");
+    LTextureAtlas atlas(LSize(100, 100), DRM_FORMAT_ARGB8888, 1);
+    const UInt32 page { LTextureAtlasTest::addPage(atlas) };
+    LPoint pos;
+
+    LAssert("The first image should be placed at the origin", LTextureAtlasTest::allocate(atlas, page, LSize(21, 11), &pos) && pos == LPoint(0, 0));
+    LAssert("Shorter images should share the shelf", LTextureAtlasTest::allocate(atlas, page, LSize(31, 6), &pos) && pos == LPoint(21, 0));
+    LAssert("Taller images should open a new shelf", LTextureAtlasTest::allocate(atlas, page, LSize(11, 21), &pos) && pos == LPoint(0, 11));
+    LAssert("The lowest shelf that fits should be used", LTextureAtlasTest::allocate(atlas, page, LSize(11, 6), &pos) && pos == LPoint(52, 0));
+    LAssert("Images wider than the shelf remainder should skip it", LTextureAtlasTest::allocate(atlas, page, LSize(61, 9), &pos) && pos == LPoint(11, 11));
+    LAssert("Shelves should be created only when needed", LTextureAtlasTest::shelvesCount(atlas, page) == 2);
+    LAssert("Images taller than the space left should not fit", !LTextureAtlasTest::allocate(atlas, page, LSize(10, 69), &pos));
+    LAssert("Images filling the space left should fit", LTextureAtlasTest::allocate(atlas, page, LSize(100, 68), &pos) && pos == LPoint(0, 32));
+    LAssert("Pages without room left should reject images", !LTextureAtlasTest::allocate(atlas, page, LSize(38, 1), &pos));
+}
+
+void LTextureAtlas_test_02()
+{
+    LSetTestName("LTextureAtlas_test_02");
+    LTextureAtlas atlas(LSize(100, 100), DRM_FORMAT_ARGB8888, 1);
+    const UInt32 page { LTextureAtlasTest::addPage(atlas) };
+
+    LTextureAtlas::Entry *a { LTextureAtlasTest::addEntry(atlas, page, LSize(51, 51)) };
+    LTextureAtlas::Entry *b { LTextureAtlasTest::addEntry(atlas, page, LSize(41, 41)) };
+    LAssert("Entries should exclude the padding", a && b && a->rectB() == LRect(0, 0, 50, 50) && b->rectB() == LRect(51, 0, 40, 40));
+    LAssert("Entries should be counted", atlas.entriesCount() == 2);
+
+    atlas.remove(a);
+    LAssert("Pages with entries left should keep their space", atlas.entriesCount() == 1 && LTextureAtlasTest::shelvesCount(atlas, page) == 1);
+
+    LPoint pos;
+    LAssert("Space of removed entries should not be reused while the page has entries",
+            LTextureAtlasTest::allocate(atlas, page, LSize(41, 41), &pos) && pos == LPoint(0, 51));
+
+    atlas.remove(b);
+    LAssert("Empty pages should be reset", atlas.entriesCount() == 0 && atlas.pagesCount() == 1 && LTextureAtlasTest::shelvesCount(atlas, page) == 0);
+    LAssert("Reset pages should be cleared before reusing them", LTextureAtlasTest::needsClear(atlas, page));
+
+    b = LTextureAtlasTest::addEntry(atlas, page, LSize(100, 100));
+    LAssert("Reset pages should be reused from the origin", b && b->rectB() == LRect(0, 0, 99, 99));
+
+    atlas.remove(b);
+    atlas.remove(b);
+    LAssert("Removing an entry twice should be a no-op", atlas.entriesCount() == 0);
+
+    LTextureAtlasTest::addEntry(atlas, page, LSize(10, 10));
+    LTextureAtlasTest::addEntry(atlas, page, LSize(10, 10));
+    atlas.clear();
+    LAssert("Clearing should remove all entries and keep the pages", atlas.entriesCount() == 0 && atlas.pagesCount() == 1 && LTextureAtlasTest::shelvesCount(atlas, page) == 0);
+
+    UInt8 pixel[4] {};
+    LAssert("Images larger than the page should be rejected", atlas.add(LSize(100, 100), 400, pixel) == nullptr && atlas.pagesCount() == 1);
+    LAssert("Empty images should be rejected", atlas.add(LSize(0, 10), 0, pixel) == nullptr);
+}
+
+void LTextureAtlas_run_tests()
+{
+    LTextureAtlas_test_01();
+    LTextureAtlas_test_02();
+}
+
+#endif // LTEXTUREATLAS_TEST_H
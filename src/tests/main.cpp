@@ -10,6 +10,12 @@ using namespace Louvre;
 #include "LWeak_test.h"
 #include "LRegion_test.h"
 #include "LBitset_tests.h"
+#include "LLatencyHistogram_test.h"
+#include "LFrameScheduler_test.h"
+#include "LOrderChangeFilter_test.h"
+#include "LSceneView_test.h"
+#include "LTextureAtlas_test.h"
+#include "LPointer_test.h"
 
 int main(int, char *[])
 {
@@ -20,6 +26,12 @@ int main(int, char *[])
     LWeak_run_tests();
     LRegion_run_tests();
     LBitset_run_tests();
+    LLatencyHistogram_run_tests();
+    LFrameScheduler_run_tests();
+    LOrderChangeFilter_run_tests();
+    LSceneView_run_tests();
+    LTextureAtlas_run_tests();
+    LPointer_run_tests();
 
     return 0;
 }